@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <thread>
+#include "progress.hpp"
+
+namespace parallel
+{
+    // Runs one long job at a time on its own thread, so the caller (the GUI
+    // loop) never blocks on it. The job reports into progress() and returns
+    // early once it is cancelled. It writes its results into storage the
+    // caller owns, which the caller reads after take_finished() returns true.
+    class BackgroundTask
+    {
+    public:
+        using Job = std::function<void(Progress& progress)>;
+
+        BackgroundTask() = default;
+        ~BackgroundTask(); // Cancels a running job and waits for it
+
+        BackgroundTask(const BackgroundTask&) = delete;
+        BackgroundTask& operator=(const BackgroundTask&) = delete;
+
+        bool start(Job job); // False while another job is still running
+        void cancel(); // Asks the running job to stop, it still finishes through take_finished
+        bool running() const { return busy.load(std::memory_order_acquire); }
+        bool take_finished(); // True once per finished job, its results are then safe to read
+        bool has_finished() const { return finished.load(std::memory_order_acquire); } // A finished job take_finished has not picked up yet
+        const Progress& progress() const { return state; }
+
+    private:
+        std::thread thread;
+        Progress state;
+        std::atomic<bool> busy{false};
+        std::atomic<bool> finished{false};
+    };
+}
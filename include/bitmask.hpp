@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "board.hpp"
+
+// Candidate masks with one bit per digit, the width is picked at compile time
+// from the board size so the solver keeps single word operations up to 64 digits.
+namespace bitmask
+{
+    using Wide = unsigned __int128; // 128-bit mask, enough for 81x81 and 100x100 boards
+
+    static_assert(MAX_BOARD_SIZE <= 128, "Wide is the widest mask");
+
+    // Smallest mask type holding n digits
+    template <int N>
+    using MaskFor = std::conditional_t<N <= 32, std::uint32_t,
+                    std::conditional_t<N <= 64, std::uint64_t, Wide>>;
+
+    template <typename Mask>
+    struct Tag
+    {
+        using type = Mask;
+    };
+
+    // Calls f(Tag<Mask>{}) with the mask type fitting a board of size n
+    template <typename F>
+    void dispatch(int n, F&& f)
+    {
+        if (n <= 32) f(Tag<MaskFor<32>>{});
+        else if (n <= 64) f(Tag<MaskFor<64>>{});
+        else f(Tag<MaskFor<128>>{});
+    }
+
+    // Mask with only bit i set
+    template <typename Mask>
+    inline Mask bit(int i)
+    {
+        return Mask(1) << i;
+    }
+
+    // Mask with the lowest n bits set (n may equal the full width)
+    template <typename Mask>
+    inline Mask low(int n)
+    {
+        constexpr int width = sizeof(Mask) * 8;
+        return n >= width ? ~Mask(0) : (Mask(1) << n) - 1;
+    }
+
+    template <typename Mask>
+    inline bool any(const Mask& m)
+    {
+        return static_cast<bool>(m);
+    }
+
+    // Index of the lowest set bit, the mask must not be empty
+    inline int ctz(std::uint32_t m) { return __builtin_ctz(m); }
+    inline int ctz(std::uint64_t m) { return __builtin_ctzll(m); }
+    inline int ctz(Wide m)
+    {
+        std::uint64_t lo = (std::uint64_t)m;
+        return lo ? __builtin_ctzll(lo) : 64 + __builtin_ctzll((std::uint64_t)(m >> 64));
+    }
+
+    inline int popcount(std::uint32_t m) { return __builtin_popcount(m); }
+    inline int popcount(std::uint64_t m) { return __builtin_popcountll(m); }
+    inline int popcount(Wide m) { return __builtin_popcountll((std::uint64_t)m) + __builtin_popcountll((std::uint64_t)(m >> 64)); }
+
+    // Clears the lowest set bit
+    template <typename Mask>
+    inline Mask clear_lowest(Mask m)
+    {
+        return m & (m - 1);
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "board.hpp"
+#include "solve.hpp"
+#include "search_stats.hpp"
+
+namespace solver
+{
+    // 9x9 solver on digit-plane bitboards: every digit keeps one 27-bit word per
+    // band of three rows marking the cells where it can still go, so placing a
+    // digit and finding singles are a few AND/OR operations over all planes.
+    // The kernel uses AVX2 when the CPU has it (checked once at runtime) and
+    // falls back to portable scalar code otherwise.
+    Result solve_bitplane9(Board& board, long long* nodes = nullptr, SearchStats* stats = nullptr);
+
+    const char* bitplane9_isa(); // "avx2" or "scalar", the kernel picked for this CPU
+}
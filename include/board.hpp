@@ -0,0 +1,91 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#define MAX_BOARD_SIZE 100 // Maximum board size supported
+
+namespace solver
+{
+    // Strided view over the n cells of one unit (row, column or subgrid).
+    // Cell i lives at first[(i / width) * stride + i % width].
+    template <typename Cell>
+    class UnitView
+    {
+    public:
+        UnitView(Cell* first, int width, int stride) : first(first), width(width), stride(stride) {}
+
+        Cell& operator[](int i) const { return first[(i / width) * stride + i % width]; }
+
+    private:
+        Cell* first;
+        int width; // Cells per line of the unit
+        int stride; // Distance between two lines of the unit
+    };
+
+    // Square row-major grid stored in one contiguous block.
+    // board[row][col] indexes it like the old vector of vectors.
+    template <typename Cell>
+    class BasicGrid
+    {
+    public:
+        BasicGrid() = default;
+        explicit BasicGrid(int size, Cell fill = 0) : n(size), cells(size * size, fill) {}
+
+        std::size_t size() const { return n; } // Side length, not the number of cells
+
+        Cell* operator[](int row) { return cells.data() + row * n; }
+        const Cell* operator[](int row) const { return cells.data() + row * n; }
+
+        Cell* data() { return cells.data(); }
+        const Cell* data() const { return cells.data(); }
+
+        void assign(int size, Cell fill = 0)
+        {
+            n = size;
+            cells.assign(size * size, fill);
+        }
+
+        void fill(Cell v) { std::fill(cells.begin(), cells.end(), v); }
+
+        UnitView<Cell> row(int r) { return {cells.data() + r * n, n, n}; }
+        UnitView<Cell> col(int c) { return {cells.data() + c, 1, n}; }
+        UnitView<Cell> box(int b, int box_size) { return {cells.data() + (b / box_size) * box_size * n + (b % box_size) * box_size, box_size, n}; }
+        UnitView<const Cell> row(int r) const { return {cells.data() + r * n, n, n}; }
+        UnitView<const Cell> col(int c) const { return {cells.data() + c, 1, n}; }
+        UnitView<const Cell> box(int b, int box_size) const { return {cells.data() + (b / box_size) * box_size * n + (b % box_size) * box_size, box_size, n}; }
+
+        bool operator==(const BasicGrid& other) const { return n == other.n && cells == other.cells; }
+        bool operator!=(const BasicGrid& other) const { return !(*this == other); }
+
+    private:
+        int n = 0;
+        std::vector<Cell> cells;
+    };
+
+    static_assert(MAX_BOARD_SIZE <= 255, "Board cells are stored in a byte");
+
+    using Board = BasicGrid<std::uint8_t>; // Cell values, 0 marks an empty cell
+    using FlagBoard = BasicGrid<std::uint8_t>; // One flag per cell (no vector<bool> proxies)
+    using SubgridLut = int[MAX_BOARD_SIZE][MAX_BOARD_SIZE]; // Subgrid index of every cell
+
+    // Side of the subgrids of a size x size board, 0 when size is not a supported square
+    inline int subgrid_size_of(int size)
+    {
+        int root = 1;
+        while (root * root < size) ++root;
+        return root * root == size && size > 1 && size <= MAX_BOARD_SIZE ? root : 0;
+    }
+
+    inline void fill_subgrid_lut(SubgridLut& subgrid_lut, int size, int subgrid_size)
+    {
+        for (int r = 0; r < size; ++r)
+        {
+            for (int c = 0; c < size; ++c)
+            {
+                subgrid_lut[r][c] = (r / subgrid_size) * subgrid_size + c / subgrid_size;
+            }
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "board.hpp"
+
+namespace solver
+{
+    // How many times every number appears in every row, column and box of a
+    // board, kept up to date one write at a time. Every query is O(1): the
+    // board is solved when all cells are filled and no number repeats in a
+    // unit, and a cell conflicts when its number repeats in one of its units.
+    class ConstraintTracker
+    {
+    public:
+        void reset(const Board& board, int subgrid_size); // O(n^2), after the whole board changed
+        void set(int row, int col, int old_value, int new_value); // O(1), after one cell changed
+
+        bool is_solved() const { return filled == cells && repeats == 0; }
+        bool has_conflicts() const { return repeats != 0; }
+        bool conflicts(int row, int col, int value) const; // Whether value at (row, col) repeats in a unit
+        int get_filled() const { return filled; }
+
+    private:
+        int size = 0;
+        int cells = 0;
+        int filled = 0; // Non-zero cells
+        long long repeats = 0; // Sum over units and numbers of count - 1 where count > 1
+        int subgrid_size = 1;
+        std::vector<uint16_t> row_counts; // [unit * (size + 1) + number]
+        std::vector<uint16_t> col_counts;
+        std::vector<uint16_t> box_counts;
+
+        int box_of(int row, int col) const { return (row / subgrid_size) * subgrid_size + col / subgrid_size; }
+        void add(std::vector<uint16_t>& counts, int unit, int value);
+        void remove(std::vector<uint16_t>& counts, int unit, int value);
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "board.hpp"
+#include "progress.hpp"
+#include "search_stats.hpp"
+
+namespace solver
+{
+    // Exact-cover solver (Knuth's Algorithm X on Dancing Links)
+    // Every empty cell/digit pair is a matrix row covering four columns:
+    // the cell itself, the digit in its row, in its column and in its subgrid.
+    class DancingLinks
+    {
+    public:
+        DancingLinks(int size, int subgrid_size);
+
+        bool load(const Board& board); // Builds the matrix for the empty cells, false if the givens conflict
+        bool solve(Board& board); // Fills the loaded board in place, false if no solution exists
+        long long get_nodes() const { return nodes; } // Rows tried during the last solve (over all restarts)
+        int get_size() const { return size; }
+        int get_depth() const { return (int)choice.size(); }
+        int get_cell() const { return choice.empty() ? -1 : row_of[choice.back()] / size; } // Row-major cell of the last choice
+        void store(Board& board) const; // The loaded board with the current choices filled in
+        void set_progress(parallel::Progress* report) { progress = report; } // Reported to, and solve gives up when it is cancelled
+        void set_stats(SearchStats* report) { stats = report; } // Filled by solve, over all restarts
+
+    private:
+        int size;
+        int subgrid_size;
+        long long nodes = 0;
+        int givens = 0; // Filled cells of the loaded board
+        Board loaded; // The board load was given, for store
+        parallel::Progress* progress = nullptr;
+        SearchStats* stats = nullptr;
+
+        // Node storage, index 0 is the root header, 1..columns are the column headers
+        std::vector<int> left, right, up, down, column;
+        std::vector<int> column_size; // Number of rows still linked in each column
+        std::vector<int> row_of; // Matrix row (candidate placement) of every node
+        std::vector<int> choice; // Explicit search stack, one chosen node per level
+        std::uint32_t tie_break = 0; // xorshift state used to break MRV ties after a restart
+
+        enum class SearchResult { Found, Exhausted, Limit, Cancelled };
+
+        void add_row(int row_id, const int columns[4]);
+
+        int choose_column(); // Column with the fewest rows left (MRV)
+        void cover(int c);
+        void uncover(int c);
+        SearchResult search(long long limit); // Depth first search, gives up after limit rows
+        void unwind(); // Undoes every choice, restoring the loaded matrix
+    };
+}
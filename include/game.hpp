@@ -1,15 +1,18 @@
 #pragma once
 #include <iostream>
 #include <vector>
-#include <unordered_map>
 #include "gui.hpp"
-#include <bitset>
+#include "game_state.hpp"
+#include "thread_pool.hpp"
+#include "puzzle_pool.hpp"
+#include "puzzle_bank.hpp"
+#include "background_task.hpp"
+#include "search_watch.hpp"
 
-#define MAX_BOARD_SIZE 100 // Maximum board size supported
-#define MAX_SOLVE_SIZE 9 // Maximum board size that can be solved by AI
+#define PUZZLE_BANK_PATH "puzzles.bank" // Optional bank built by sudoku-bank, used when no generated puzzle is ready
 
-// Represents the Sudoku game logic and management
-class Game
+// Represents the Sudoku game: the headless solver::GameState plus its window
+class Game : public solver::GameState
 {
     friend class Gui; // Allows Gui class to access private members
 
@@ -18,51 +21,32 @@ public:
     void run(); // Main game loop
 
 private:
-    using BitBoard = unsigned int; // Used for bitmasking row/column/subgrid constraints
-    using Board = std::vector<std::vector<int>>; // 2D vector representing the Sudoku board
-    using BoolBoard = std::vector<std::vector<bool>>; // 2D vector used for checking cells stated
+    using Board = solver::Board; // Contiguous grid representing the Sudoku board
+    using BoolBoard = solver::FlagBoard; // Contiguous grid used for checking cells stated
 
-    static const std::unordered_map<int, int> subgrid_size_map; // Maps board sizes to their subgrid sizes
-
-    int subgrid_lut[MAX_BOARD_SIZE][MAX_BOARD_SIZE] = {}; // Lookup table for subgrid indices
-    Board board; // The Sudoku board
-    Board known_solution; // The solution (if known)
-    bool is_solution_known = false;
-    BoolBoard from_puzzle; // The part of the board that was already solved
-    int subgrid_size; // Size of each subgrid
     bool running = true; // Controls the game loop
 
-    void initialize_subgrid_lut(int size); // Initializes the subgrid lookup table
-    bool is_valid_board_size(int size); // Checks if a board size is supported
     void change_board_size_if_valid(int size); // Changes board size if it's valid
-
-    void clear_board(); // Clears the board
-    void clear_from_puzzle(); // Sets all cells of from_puzzle to false
-    bool in_range(int v); // Checks if a value is within board range
-    bool is_solved(); // Checks if the board is solved
-
-    void fit_known_solution_vec();
-
-    void set_from_puzzle_as_state(); // Sets from_puzzle according to the current board
-
-    // Solver function using backtracking with bitmask optimizations
-    bool solver(Board& board, int row, int col, BitBoard seen_row[MAX_SOLVE_SIZE], 
-                BitBoard seen_col[MAX_SOLVE_SIZE], BitBoard seen_subgrid[MAX_SOLVE_SIZE], int n);
-
-    void solve_board(); // Solves the current board
-
+    void solve_board(); // Starts solving the current board in the background
+    void generate_puzzle(int level); // Starts generating a puzzle of the current size in the background
+    void finish_job(); // Commits the result of a finished background job, reporting failures on screen
+    void warm_puzzles(); // Has puzzles of the current size generated in the background
+
+    parallel::WorkStealingPool pool; // Worker threads shared by the parallel solver
+    generator::PuzzlePool puzzles; // Puzzles generated ahead for the Puzzle button
+    generator::PuzzleBank bank; // Pre-built puzzles, also for sizes past MAX_GENERATE_SIZE
+
+    // Solving and generating run on task so the window stays responsive. The
+    // job works on these copies and finish_job installs the result.
+    enum class Job { None, Solve, Generate };
+    Job job = Job::None;
+    Board job_puzzle; // Board the solve started from, or the generated puzzle
+    Board job_solution;
+    solver::Result job_result = solver::Result::Unsolvable;
+    double job_ms = 0; // Wall time of the job
+    bool job_short = false; // The generated puzzle kept more clues than its level asks
+    solver::SearchStats job_stats; // What the solve did, empty when statistics are compiled out
+    parallel::SearchWatch watch; // Snapshots of a solve for the GUI to follow
+    parallel::BackgroundTask task; // Declared after what its job uses, so it is joined first
     Gui gui; // Graphical User Interface for the game
-
-
-    // Copies board content safely
-    template <typename T>
-    void copy_board(std::vector<std::vector<T>>& source, std::vector<std::vector<T>>& dest)
-    {
-        int size = std::min(source.size(), dest.size());
-
-        for (int i = 0; i < size; ++i)
-        {
-            std::copy_n(source[i].begin(), size, dest[i].begin());
-        }
-    }
 };
@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include "board.hpp"
+#include "constraint_tracker.hpp"
+#include "solve.hpp"
+#include "thread_pool.hpp"
+
+namespace solver
+{
+    // Headless state of a game: the board, the cells given by the puzzle, the
+    // known solution and the subgrid geometry. No SFML here, the GUI's Game
+    // derives from it and only adds the window and the messages.
+    class GameState
+    {
+    public:
+        GameState(int board_size = 9); // Throws std::invalid_argument on an unsupported size
+
+        static bool is_valid_board_size(int size); // Perfect squares from 4 to MAX_BOARD_SIZE
+
+        const Board& get_board() const { return board; }
+        const FlagBoard& get_from_puzzle() const { return from_puzzle; }
+        const Board& get_known_solution() const { return known_solution; }
+        bool get_is_solution_known() const { return is_solution_known; }
+        int get_subgrid_size() const { return subgrid_size; }
+        const SubgridLut& get_subgrid_lut() const { return subgrid_lut; }
+
+        void set_cell(int row, int col, int num) // O(1), the only way single cells change
+        {
+            tracker.set(row, col, board[row][col], num);
+            board[row][col] = num;
+        }
+        void set_puzzle(const Board& puzzle, const Board& solution); // Loads a generated puzzle and its solution
+        bool resize(int size); // Keeps what fits, false when some values were out of range and erased
+
+        void clear_board(); // Clears the board
+        void reset_board(); // Erases what was typed, the givens stay
+        bool fill_known_solution(); // Writes the known solution over the board, false when none is known
+        void clear_from_puzzle(); // Sets all cells of from_puzzle to false
+        bool in_range(int v) const; // Checks if a value is within board range
+        bool is_solved() const { return tracker.is_solved(); } // O(1)
+        bool has_conflicts() const { return tracker.has_conflicts(); } // O(1), some number repeats in a unit
+        bool conflicts(int row, int col) const { return tracker.conflicts(row, col, board[row][col]); } // O(1)
+        void set_from_puzzle_as_state(); // Sets from_puzzle according to the current board
+
+        Result solve(parallel::WorkStealingPool* pool = nullptr, SearchStats* stats = nullptr); // Solves the board in place (see solver::solve), the filled cells become givens
+        bool commit_solution(const Board& puzzle, const Board& solved); // Installs a solution found off a copy, false if the board no longer holds puzzle
+
+    protected:
+        SubgridLut subgrid_lut = {}; // Lookup table for subgrid indices
+        Board board; // The Sudoku board
+        Board known_solution; // The solution (if known)
+        bool is_solution_known = false;
+        FlagBoard from_puzzle; // The part of the board that was already solved
+        int subgrid_size; // Size of each subgrid
+        ConstraintTracker tracker; // Unit counts of board, reset whenever more than one cell changes
+
+        void initialize_subgrid_lut(int size); // Initializes the subgrid lookup table
+        void fit_known_solution_vec();
+
+        // Copies board content safely
+        template <typename T>
+        void copy_board(const BasicGrid<T>& source, BasicGrid<T>& dest)
+        {
+            if (source.size() == dest.size())
+            {
+                dest = source; // Same size, one contiguous copy
+                return;
+            }
+
+            int size = std::min(source.size(), dest.size());
+
+            for (int i = 0; i < size; ++i)
+            {
+                std::copy_n(source[i], size, dest[i]);
+            }
+        }
+    };
+}
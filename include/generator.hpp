@@ -4,55 +4,296 @@
 #include <random>
 #include <algorithm>
 #include <iostream>
+#include <atomic>
+#include <cstdint>
+#include "board.hpp"
+#include "solution_counter.hpp"
+#include "rating.hpp"
+#include "xoshiro.hpp"
+#include "thread_pool.hpp"
+#include "progress.hpp"
+
+#define MAX_GENERATE_SIZE 25 // Largest board size puzzles are generated for on demand (clue removal slows down past it)
+#define PARALLEL_GENERATE_SIZE 16 // Boards from this size up gain from SudokuGenerator::set_pool, smaller ones lose to the task overhead
 
 namespace generator
 {
-    using Board = std::vector<std::vector<int>>;
+    using Board = solver::Board;
+
+    // How generate_solved builds a full grid
+    enum class FillMode
+    {
+        Backtracking, // Random backtracking, reaches any grid but stalls past 16x16
+        Pattern // Scrambled base pattern, linear time for every size
+    };
+
+    // Backtracking keeps the variety of small boards, bigger ones need the pattern
+    inline FillMode default_fill_mode(int size)
+    {
+        return size <= 9 ? FillMode::Backtracking : FillMode::Pattern;
+    }
+
+    // Clues left for difficulty level 1 (easiest) to 5, never below a quarter of the cells
+    inline int clues_for_level(int level, int size)
+    {
+        int total_cells = size * size;
+        int min_clues = total_cells / 4 + 1;
+
+        level = std::max(1, std::min(level, 5));
+
+        double clue_percentages[5] = { 0.85, 0.75, 0.60, 0.45, 0.25 };
+
+        return std::max(min_clues, static_cast<int>(total_cells * clue_percentages[level - 1]));
+    }
+
+    // Hardest technique a puzzle of difficulty level 1 (easiest) to 5 may need.
+    // A puzzle of a level needs more than the level below allows.
+    inline solver::Technique technique_for_level(int level)
+    {
+        static const solver::Technique techniques[5] =
+        {
+            solver::Technique::HiddenSingle,
+            solver::Technique::NakedSingle,
+            solver::Technique::LockedCandidates,
+            solver::Technique::Pair,
+            solver::Technique::Search
+        };
+        return techniques[std::max(1, std::min(level, 5)) - 1];
+    }
 
     class SudokuGenerator
     {
     public:
-        SudokuGenerator(int size) :
+        // The same size, mode and seed always give the same sequence of puzzles.
+        // All scratch space is allocated here and reused by every call.
+        SudokuGenerator(int size, FillMode mode, std::uint64_t seed) :
             size(size),
             box_size(static_cast<int>(std::sqrt(size))),
-            board(size, std::vector<int>(size, 0))
+            mode(mode),
+            board(size),
+            trial(size),
+            rng(seed),
+            numbers(mode == FillMode::Backtracking ? size * size * size : 0),
+            next_number(mode == FillMode::Backtracking ? size * size : 0),
+            positions(size * size),
+            rows(size),
+            cols(size),
+            digits(size),
+            bands(box_size),
+            inner(box_size)
         {
             if (!is_valid_size(size))
             {
                 throw std::invalid_argument("Invalid Sudoku size.");
             }
+            counter = solver::make_solution_counter(size);
             initialize_lookup_tables();
         }
 
+        // Seeded from std::random_device, for callers that want variety over repeatability
+        SudokuGenerator(int size, FillMode mode) : SudokuGenerator(size, mode, random_seed()) {}
+        SudokuGenerator(int size) : SudokuGenerator(size, default_fill_mode(size)) {}
+
+        // Restarts the sequence, as if constructed with this seed
+        void seed(std::uint64_t value) { rng.reseed(value); }
+
         Board generate_solved()
         {
-            board.assign(size, std::vector<int>(size, 0));
-            fill_board();
+            fill_solved();
             return board;
         }
 
-        Board generate_puzzle(int clues, Board& solution)
+        // While *stop is set, generate_puzzle returns early with more clues than
+        // asked (still a unique puzzle), for callers that shut down mid-generation
+        void set_stop_flag(const std::atomic<bool>* flag) { stop = flag; }
+
+        // With a pool, clue removal checks batches of candidates concurrently
+        // (see remove_parallel); nullptr goes back to one check at a time. The
+        // puzzles differ from the serial ones but stay fixed for a seed and pool size.
+        void set_pool(parallel::WorkStealingPool* workers) { pool = workers; }
+
+        // Reports clues removed so far into report->cells, adds the branches of
+        // the uniqueness checks to report->nodes and stops early (as with
+        // set_stop_flag) once report->cancel is set
+        void set_progress(parallel::Progress* report)
+        {
+            progress = report;
+            stop = report ? &report->cancel : nullptr;
+        }
+
+        // Unique puzzle with clues givens. Clues are removed while the puzzle
+        // stays unique, so a grid can run out of removable clues first; the
+        // puzzle then keeps more, and the overload below returns false.
+        // max_nodes opts into a cap on each uniqueness check: a check needing
+        // more branches keeps its clue, which bounds the time on boards past
+        // 25x25 at the price of more clues left. 0 checks every removal fully.
+        Board generate_puzzle(int clues, Board& solution, long long max_nodes = 0)
+        {
+            Board puzzle;
+            generate_puzzle(clues, puzzle, solution, max_nodes);
+            return puzzle;
+        }
+
+        // Same as above into the caller's boards, which allocate nothing once
+        // they have the size. False when the puzzle kept more than clues givens.
+        bool generate_puzzle(int clues, Board& puzzle, Board& solution, long long max_nodes = 0)
         {
             if (clues < size * size / 4 || clues > size * size)
             {
                 throw std::invalid_argument("Invalid number of clues.");
             }
 
-            Board solved_board = generate_solved();
-            solution = solved_board;
-            Board puzzle = solved_board;
-            remove_numbers(puzzle, clues);
+            fill_solved();
+            solution = board;
+            puzzle = board;
+            if (pool)
+            {
+                remove_parallel(puzzle, clues, clues, solver::Technique::None, false, solver::Technique::None, max_nodes);
+            }
+            else
+            {
+                remove_numbers(puzzle, clues, max_nodes);
+            }
+            return std::count_if(puzzle.data(), puzzle.data() + size * size, [](std::uint8_t v) { return v != 0; }) <= clues;
+        }
+
+        // Minimal puzzle: unique, and removing any one of its clues would not
+        // be. Every check runs to the end instead of giving up after a budget,
+        // so sparse 16x16 and bigger boards can take long.
+        Board generate_minimal(Board& solution)
+        {
+            Board puzzle;
+            generate_minimal(puzzle, solution);
+            return puzzle;
+        }
+
+        void generate_minimal(Board& puzzle, Board& solution)
+        {
+            fill_solved();
+            solution = board;
+            puzzle = board;
+            if (pool)
+            {
+                remove_parallel(puzzle, 0, 0, solver::Technique::None, false, solver::Technique::None, 0);
+            }
+            else
+            {
+                remove_numbers(puzzle, 0, 0);
+            }
+        }
+
+        // Puzzle of a level (1-5) judged by the techniques it needs (see
+        // technique_for_level), not just its clue count. Clues are removed while
+        // the rating stays within the level, past clues_for_level when the puzzle
+        // is still too easy there; a grid that never gets hard enough is dropped
+        // for a new one. After attempts grids the hardest puzzle found is
+        // returned. Sizes up to MAX_RATING_SIZE.
+        Board generate_rated(int level, Board& solution, solver::Rating* rating = nullptr, int attempts = 64)
+        {
+            Board puzzle;
+            generate_rated(level, puzzle, solution, rating, attempts);
             return puzzle;
         }
 
+        void generate_rated(int level, Board& puzzle, Board& solution, solver::Rating* rating = nullptr, int attempts = 64)
+        {
+            level = std::max(1, std::min(level, 5));
+            solver::Technique hardest = technique_for_level(level);
+            solver::Technique easier = level > 1 ? technique_for_level(level - 1) : solver::Technique::None;
+            if (!rater)
+            {
+                rater = std::make_unique<solver::Rater>(size);
+            }
+
+            solver::Rating best_rating;
+            for (int attempt = 0; attempt < attempts; ++attempt)
+            {
+                fill_solved();
+                trial = board;
+                int clues = clues_for_level(level, size);
+                solver::Rating trial_rating = pool ?
+                    remove_parallel(trial, size * size / 4 + 1, clues, easier, true, hardest, 4LL * size) :
+                    remove_rated(trial, clues, easier, hardest);
+                if (attempt == 0 || trial_rating.hardest > best_rating.hardest)
+                {
+                    puzzle = trial;
+                    solution = board;
+                    best_rating = trial_rating;
+                }
+                if (best_rating.hardest > easier || (stop && stop->load(std::memory_order_relaxed)))
+                {
+                    break;
+                }
+            }
+
+            if (rating) *rating = best_rating;
+        }
+
     private:
         int size;
         int box_size;
-        Board board;
-        std::vector<std::vector<bool>> row_lookup;
-        std::vector<std::vector<bool>> col_lookup;
-        std::vector<std::vector<bool>> box_lookup;
-        std::mt19937 rng{std::random_device{}()};
+        FillMode mode;
+        Board board; // The last solved grid
+        Board trial; // Puzzle being carved by generate_rated
+        solver::FlagBoard row_lookup; // row_lookup[row][num - 1] is set when num is in the row
+        solver::FlagBoard col_lookup;
+        solver::FlagBoard box_lookup;
+        Xoshiro256 rng;
+
+        // Scratch space of the iterative searches, allocated once per generator
+        std::vector<int> numbers; // Shuffled digit order of every cell, size entries per cell
+        std::vector<int> next_number; // Next entry of numbers to try at every cell
+        std::vector<int> positions; // Clue removal order
+        std::vector<int> rows; // Line orders and relabelling of fill_pattern
+        std::vector<int> cols;
+        std::vector<int> digits;
+        std::vector<int> bands;
+        std::vector<int> inner;
+        std::unique_ptr<solver::SolutionCounter> counter; // Uniqueness checks of remove_numbers
+        const std::atomic<bool>* stop = nullptr;
+        std::unique_ptr<solver::Rater> rater; // Created by the first generate_rated
+        parallel::WorkStealingPool* pool = nullptr;
+        parallel::Progress* progress = nullptr;
+
+        // Scratch of one concurrent removal check
+        struct RemovalSlot
+        {
+            Board puzzle;
+            std::unique_ptr<solver::SolutionCounter> counter;
+            std::unique_ptr<solver::Rater> rater;
+            solver::Rating rating;
+            bool removable = false;
+        };
+        std::vector<RemovalSlot> slots; // One per candidate of a batch
+        std::vector<int> passed; // Candidates of a batch that can go on their own
+
+        static std::uint64_t random_seed()
+        {
+            std::random_device device;
+            return (std::uint64_t)device() << 32 ^ device();
+        }
+
+        void fill_solved()
+        {
+            if (mode == FillMode::Pattern)
+            {
+                fill_pattern();
+                return;
+            }
+            board.assign(size);
+            initialize_lookup_tables();
+            fill_board();
+        }
+
+        void report(int remaining)
+        {
+            if (progress) progress->cells.store(size * size - remaining, std::memory_order_relaxed);
+        }
+
+        void report_nodes(long long nodes)
+        {
+            if (progress) progress->nodes.fetch_add(nodes, std::memory_order_relaxed); // Parallel checks add concurrently
+        }
 
         bool is_valid_size(int n)
         {
@@ -62,77 +303,189 @@ namespace generator
 
         void initialize_lookup_tables()
         {
-            row_lookup.assign(size, std::vector<bool>(size + 1, false));
-            col_lookup.assign(size, std::vector<bool>(size + 1, false));
-            box_lookup.assign(size, std::vector<bool>(size + 1, false));
+            row_lookup.assign(size, false);
+            col_lookup.assign(size, false);
+            box_lookup.assign(size, false);
         }
 
-        bool fill_board(int row = 0, int col = 0)
+        // Random backtracking over the cells in row-major order, with an explicit
+        // position instead of one call per cell
+        bool fill_board()
         {
-            if (row == size)
+            int cells = size * size;
+            int pos = 0;
+            shuffle_numbers(pos);
+
+            while (pos >= 0)
             {
-                return true;
-            }
+                if (pos == cells)
+                {
+                    return true;
+                }
 
-            int next_row = (col == size - 1) ? row + 1 : row;
-            int next_col = (col + 1) % size;
+                int row = pos / size;
+                int col = pos % size;
+                if (board[row][col] != 0)
+                {
+                    remove_number(row, col, board[row][col]); // Back from a dead end
+                }
 
-            std::vector<int> numbers(size);
-            std::iota(numbers.begin(), numbers.end(), 1);
-            std::shuffle(numbers.begin(), numbers.end(), rng);
+                const int* order = &numbers[pos * size];
+                int& next = next_number[pos];
+                while (next < size && !is_safe(row, col, order[next]))
+                {
+                    ++next;
+                }
 
-            for (int num : numbers)
-            {
-                if (is_safe(row, col, num))
+                if (next < size)
                 {
-                    place_number(row, col, num);
-                    if (fill_board(next_row, next_col))
+                    place_number(row, col, order[next++]);
+                    if (++pos < cells)
                     {
-                        return true;
+                        shuffle_numbers(pos);
                     }
-                    remove_number(row, col, num);
+                }
+                else
+                {
+                    --pos;
                 }
             }
 
             return false;
         }
 
+        // Base pattern (box_size * (r % box_size) + r / box_size + c) % size, then
+        // random band, row-in-band, stack and column-in-stack orders, a random
+        // transpose and a random digit relabelling. Each one maps valid grids to
+        // valid grids, and all of them cost O(size * size) together.
+        void fill_pattern()
+        {
+            shuffle_lines(rows);
+            shuffle_lines(cols);
+            std::iota(digits.begin(), digits.end(), 1);
+            rng.shuffle(digits.begin(), digits.end());
+            bool transpose = rng.below(2) == 1;
+
+            for (int row = 0; row < size; ++row)
+            {
+                for (int col = 0; col < size; ++col)
+                {
+                    int r = rows[row];
+                    int c = cols[col];
+                    if (transpose) std::swap(r, c);
+                    board[row][col] = digits[(box_size * (r % box_size) + r / box_size + c) % size];
+                }
+            }
+        }
+
+        // Line order keeping bands (or stacks) together: shuffled bands, each
+        // with its lines shuffled
+        void shuffle_lines(std::vector<int>& lines)
+        {
+            std::iota(bands.begin(), bands.end(), 0);
+            rng.shuffle(bands.begin(), bands.end());
+
+            int next = 0;
+            for (int band : bands)
+            {
+                std::iota(inner.begin(), inner.end(), 0);
+                rng.shuffle(inner.begin(), inner.end());
+                for (int i : inner)
+                {
+                    lines[next++] = band * box_size + i;
+                }
+            }
+        }
+
+        void shuffle_numbers(int pos)
+        {
+            int* order = &numbers[pos * size];
+            std::iota(order, order + size, 1);
+            rng.shuffle(order, order + size);
+            next_number[pos] = 0;
+        }
+
         bool is_safe(int row, int col, int num)
         {
             int box_index = (row / box_size) * box_size + (col / box_size);
-            return !row_lookup[row][num] &&
-                   !col_lookup[col][num] &&
-                   !box_lookup[box_index][num];
+            return !row_lookup[row][num - 1] &&
+                   !col_lookup[col][num - 1] &&
+                   !box_lookup[box_index][num - 1];
         }
 
         void place_number(int row, int col, int num)
         {
             int box_index = (row / box_size) * box_size + (col / box_size);
             board[row][col] = num;
-            row_lookup[row][num] = true;
-            col_lookup[col][num] = true;
-            box_lookup[box_index][num] = true;
+            row_lookup[row][num - 1] = true;
+            col_lookup[col][num - 1] = true;
+            box_lookup[box_index][num - 1] = true;
         }
 
         void remove_number(int row, int col, int num)
         {
             int box_index = (row / box_size) * box_size + (col / box_size);
             board[row][col] = 0;
-            row_lookup[row][num] = false;
-            col_lookup[col][num] = false;
-            box_lookup[box_index][num] = false;
+            row_lookup[row][num - 1] = false;
+            col_lookup[col][num - 1] = false;
+            box_lookup[box_index][num - 1] = false;
         }
 
-        void remove_numbers(Board &puzzle, int clues)
+        // Removes clues in random order while the puzzle keeps a unique solution.
+        // The counter holds the puzzle and is edited one given at a time. Proving
+        // uniqueness of a sparse puzzle is heavy tailed on big boards, so a check
+        // that needs more than max_nodes branches keeps the clue (0 never gives up).
+        void remove_numbers(Board &puzzle, int clues, long long max_nodes)
         {
             int remaining = size * size;
-            std::vector<int> positions(remaining);
             std::iota(positions.begin(), positions.end(), 0);
-            std::shuffle(positions.begin(), positions.end(), rng);
+            rng.shuffle(positions.begin(), positions.end());
 
+            counter->load(puzzle);
             for (int pos : positions)
             {
-                if (remaining <= clues)
+                if (remaining <= clues || (stop && stop->load(std::memory_order_relaxed)))
+                {
+                    break;
+                }
+
+                int row = pos / size;
+                int col = pos % size;
+                int temp = puzzle[row][col];
+                counter->remove_given(pos);
+
+                int solutions = counter->count(2, max_nodes);
+                report_nodes(counter->get_nodes());
+                if (solutions != 1)
+                {
+                    counter->add_given(pos, temp);
+                }
+                else
+                {
+                    puzzle[row][col] = 0;
+                    report(--remaining);
+                }
+            }
+        }
+
+        // Removes clues in random order while the puzzle stays unique and needs
+        // no technique harder than limit, until it is down to clues and needs more
+        // than easier. A puzzle the techniques solve is unique without a search,
+        // only stalled ones go through the bounded count.
+        solver::Rating remove_rated(Board &puzzle, int clues, solver::Technique easier, solver::Technique limit)
+        {
+            int min_clues = size * size / 4 + 1;
+            int remaining = size * size;
+            std::iota(positions.begin(), positions.end(), 0);
+            rng.shuffle(positions.begin(), positions.end());
+
+            long long max_nodes = 4LL * size;
+            solver::Rating rating = rater->rate(puzzle, limit, max_nodes);
+            report_nodes(rating.nodes);
+            for (int pos : positions)
+            {
+                bool hard_enough = remaining <= clues && rating.hardest > easier;
+                if (hard_enough || remaining <= min_clues || (stop && stop->load(std::memory_order_relaxed)))
                 {
                     break;
                 }
@@ -142,84 +495,143 @@ namespace generator
                 int temp = puzzle[row][col];
                 puzzle[row][col] = 0;
 
-                if (!has_unique_solution(puzzle))
+                solver::Rating candidate = rater->rate(puzzle, limit, max_nodes);
+                report_nodes(candidate.nodes);
+                if (candidate.solutions != 1 || candidate.hardest > limit)
                 {
                     puzzle[row][col] = temp;
                 }
                 else
                 {
-                    --remaining;
+                    rating = candidate;
+                    report(--remaining);
                 }
             }
+            return rating;
         }
 
-        bool has_unique_solution(Board puzzle)
+        // Whether slot.puzzle is still acceptable: unique and, when rated,
+        // solvable with techniques up to limit
+        bool check_slot(RemovalSlot& slot, bool rated, solver::Technique limit, long long max_nodes)
         {
-            int solutions = 0;
-            solve(puzzle, 0, 0, solutions);
+            if (rated)
+            {
+                if (!slot.rater) slot.rater = std::make_unique<solver::Rater>(size);
+                slot.rating = slot.rater->rate(slot.puzzle, limit, max_nodes);
+                report_nodes(slot.rating.nodes);
+                return slot.rating.solutions == 1 && slot.rating.hardest <= limit;
+            }
+            if (!slot.counter) slot.counter = solver::make_solution_counter(size);
+            if (!slot.counter->load(slot.puzzle)) return false;
+            int solutions = slot.counter->count(2, max_nodes);
+            report_nodes(slot.counter->get_nodes());
             return solutions == 1;
         }
 
-        void  
-        
-        solve(Board &puzzle, int row, int col, int &solutions)
+        // remove_numbers (rated false) or remove_rated (rated true) on the pool,
+        // stopping at floor clues, or at clues once the rating is past easier.
+        // Each batch checks its candidates concurrently against the current
+        // puzzle. A clue that cannot go now cannot go later either (fewer clues
+        // only allow more solutions and need harder techniques), so failed
+        // candidates are dropped for good. The passing ones are then removed in
+        // batch order for as long as the puzzle still passes without them all.
+        solver::Rating remove_parallel(Board &puzzle, int floor, int clues, solver::Technique easier,
+                                       bool rated, solver::Technique limit, long long max_nodes)
         {
-            if (row == size)
+            int remaining = size * size;
+            std::iota(positions.begin(), positions.end(), 0);
+            rng.shuffle(positions.begin(), positions.end());
+
+            int batch_size = 2 * pool->size(); // Spare tasks even out uneven check times
+            if ((int)slots.size() < batch_size)
             {
-                ++solutions;
-                return;
+                slots.resize(batch_size);
             }
 
-            int next_row = (col == size - 1) ? row + 1 : row;
-            int next_col = (col + 1) % size;
-
-            if (puzzle[row][col] != 0)
+            solver::Rating rating;
+            if (rated)
             {
-                solve(puzzle, next_row, next_col, solutions);
-                return;
+                slots[0].puzzle = puzzle;
+                check_slot(slots[0], true, limit, max_nodes);
+                rating = slots[0].rating;
             }
 
-            for (int num = 1; num <= size; ++num)
+            int next = 0;
+            while (next < (int)positions.size())
             {
-                if (is_safe_solve(puzzle, row, col, num))
+                bool hard_enough = remaining <= clues && rating.hardest > easier;
+                if (hard_enough || remaining <= floor || (stop && stop->load(std::memory_order_relaxed)))
                 {
-                    puzzle[row][col] = num;
-                    solve(puzzle, next_row, next_col, solutions);
-                    puzzle[row][col] = 0;
+                    break;
+                }
 
-                    if (solutions > 1)
+                int count = std::min({batch_size, (int)positions.size() - next, remaining - floor});
+                parallel::TaskGroup group(*pool);
+                for (int i = 0; i < count; ++i)
+                {
+                    group.run([this, &puzzle, i, next, rated, limit, max_nodes]
                     {
-                        return;
-                    }
+                        RemovalSlot& slot = slots[i];
+                        slot.puzzle = puzzle;
+                        slot.puzzle.data()[positions[next + i]] = 0;
+                        slot.removable = check_slot(slot, rated, limit, max_nodes);
+                    });
                 }
-            }
-        }
-
-        bool is_safe_solve(const Board &puzzle, int row, int col, int num)
-        {
-            int box_start_row = (row / box_size) * box_size;
-            int box_start_col = (col / box_size) * box_size;
+                group.wait();
 
-            for (int i = 0; i < size; ++i)
-            {
-                if (puzzle[row][i] == num || puzzle[i][col] == num)
+                passed.clear();
+                int first = -1; // Slot of passed[0]
+                for (int i = 0; i < count; ++i)
                 {
-                    return false;
+                    if (!slots[i].removable) continue;
+                    if (first < 0) first = i;
+                    passed.push_back(positions[next + i]);
+                }
+                next += count;
+                if (passed.empty())
+                {
+                    continue;
                 }
-            }
 
-            for (int i = 0; i < box_size; ++i)
-            {
-                for (int j = 0; j < box_size; ++j)
+                // Candidates that pass alone may not pass together. Every longer
+                // prefix of them is checked at once and the longest passing one kept.
+                int kept = 1;
+                solver::Rating kept_rating = slots[first].rating;
+                int prefixes = (int)passed.size() - 1;
+                if (prefixes > 0)
                 {
-                    if (puzzle[box_start_row + i][box_start_col + j] == num)
+                    for (int j = 1; j <= prefixes; ++j)
+                    {
+                        group.run([this, &puzzle, j, rated, limit, max_nodes]
+                        {
+                            RemovalSlot& slot = slots[j - 1];
+                            slot.puzzle = puzzle;
+                            for (int k = 0; k <= j; ++k) slot.puzzle.data()[passed[k]] = 0;
+                            slot.removable = check_slot(slot, rated, limit, max_nodes);
+                        });
+                    }
+                    group.wait();
+                    for (; kept <= prefixes && slots[kept - 1].removable; ++kept)
                     {
-                        return false;
+                        kept_rating = slots[kept - 1].rating;
                     }
                 }
-            }
 
-            return true;
+                for (int k = 0; k < kept; ++k) puzzle.data()[passed[k]] = 0;
+                remaining -= kept;
+                rating = kept_rating;
+                report(remaining);
+
+                // passed[kept] cannot go once the kept ones are gone, the ones
+                // after it go back in front of the queue
+                int retry = (int)passed.size() - kept - 1;
+                if (retry > 0)
+                {
+                    next -= retry;
+                    std::copy(passed.end() - retry, passed.end(), positions.begin() + next);
+                }
+            }
+            return rating;
         }
     };
 }
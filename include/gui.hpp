@@ -3,6 +3,10 @@
 #include <vector>
 #include <functional>
 #include <chrono>
+#include "board.hpp"
+#include "timing.hpp"
+#include "search_watch.hpp"
+#include "search_stats.hpp"
 
 class Game;
 class Gui;
@@ -27,7 +31,7 @@ public:
     
     void set_str(const std::string& text);
     void set_ok(const std::string& text);
-    void draw(sf::RenderWindow& window);
+    void draw(Gui* gui);
     
     bool contains(sf::Vector2f point); // Checks if a point is inside the button
     bool ok_contains(sf::Vector2f point); // Checks if a point is inside the confirmation button
@@ -65,6 +69,47 @@ class Gui
     sf::Vector2f mouse_position; // Mouse position in the window
     sf::Font font; // Font used in the GUI
 
+    // The board is drawn from two vertex arrays instead of a shape and a text per cell
+    sf::VertexArray board_grid{sf::Quads}; // Cell backgrounds and grid lines, rebuilt with the board size
+    sf::VertexArray board_digits{sf::Quads}; // One quad per filled cell, textured from glyph_atlas
+    sf::RenderTexture glyph_atlas; // Numbers 1 to n in white, one slot each, at the current square size
+    int atlas_columns = 1; // Slots per row of the atlas
+    int atlas_slot = 1; // Side of a slot in pixels
+
+    // Frames are drawn only when something changed: the board itself lives in
+    // board_layer and only the cells whose value changed are redrawn into it
+    sf::RenderTexture board_layer; // The board without highlights, kept between frames
+    solver::Board drawn_board; // Values board_layer shows
+    solver::FlagBoard drawn_fixed; // Givens board_layer shows
+    solver::FlagBoard drawn_conflicts; // Cells board_layer shows in the conflict color
+    bool board_layer_stale = true; // Redraw all of board_layer (new size or atlas)
+    bool needs_present = true; // The window shows an out of date frame
+    sf::Vector2i drawn_hover = {-1, -1}; // Highlights of the frame on screen
+    sf::Vector2i drawn_selected = {-1, 0};
+    std::size_t drawn_messages = 0;
+    bool drawn_job = false; // The frame on screen shows a background job's progress
+
+    // Watching the solver, toggled with F4: a solve started while it is on
+    // publishes snapshots of its search, drawn over the board as they come
+    bool watch_solver = false;
+    parallel::SearchSnapshot snapshot; // The latest snapshot taken from game->watch
+    sf::VertexArray snapshot_digits{sf::Quads}; // Numbers the search placed, over the empty cells
+
+    // Timing overlay, toggled with F3. While it is hidden every timer is
+    // handed nullptr and records nothing
+    bool timings_shown = false;
+    timing::Histogram frame_times; // Drawing a frame, without the frame limiter's wait
+    timing::Histogram layer_times; // Diffing the board and redrawing changed cells into board_layer
+    timing::Histogram board_times; // render_board
+    timing::Histogram panel_times; // render_left_side
+    timing::Histogram input_times; // One event through handle_event
+    timing::Histogram draw_counts; // Draw calls per frame
+    timing::Histogram solve_times{16}; // Background jobs, added as they finish
+    timing::Histogram generate_times{16};
+    long long solve_nodes = 0; // Nodes of the last solve
+    solver::SearchStats solve_stats; // And the rest of what it did
+    int frame_draws = 0; // Draw calls since the last frame was shown
+
     std::vector<OkButton> buttons; // List of buttons in the UI
     std::vector<Massage> messages; // Displayed messages
 
@@ -72,11 +117,24 @@ class Gui
 
     void update(); // Updates the GUI state
     void render(); // Renders the GUI elements
-    void input(); // Handles user input
+    void input(); // Handles user input, sleeping until there is some when nothing is animating
+    void handle_event(const sf::Event& e);
 
     void render_board(); // Renders the game board
+    void build_board_grid(); // Fills board_grid for the current board size
+    void build_glyph_atlas(); // Renders every number of the current board size into glyph_atlas
+    void build_board_digits(int row0, int row1, int col0, int col1); // Fills board_digits from the values of a block of cells
+    void update_board_layer(); // Redraws the block of cells that changed since the last frame
+    sf::Vector2i hovered_cell() const; // Cell under the mouse, x -1 when outside the board
     void render_left_side(); // Renders the left UI panel
+    void render_progress(); // Renders the progress of a background job
+    bool watching_search() const; // A solve that publishes snapshots is running
+    void render_snapshot(); // Renders the search's placements and current cell over the board
     void render_messages(); // Renders floating messages
+    void render_timings(); // Renders the timing overlay
+    timing::Histogram* timer(timing::Histogram& histogram) { return timings_shown ? &histogram : nullptr; }
+    void toggle_timings();
+    void draw(sf::RenderTarget& target, const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default); // Counted draw call
 
     void handle_button_click(); // Handles button click events
 
@@ -98,4 +156,5 @@ class Gui
     void initialize_buttons(); // Initializes all UI buttons
 
     static void center_text(sf::Text& text, sf::Vector2f center); // Centers text at a given position
+    static void add_quad(sf::VertexArray& quads, sf::FloatRect rect, sf::Color color, sf::FloatRect tex = {}); // Appends a rectangle
 };
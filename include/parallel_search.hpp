@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "search.hpp"
+#include "thread_pool.hpp"
+#include "progress.hpp"
+#include "search_watch.hpp"
+
+namespace solver
+{
+    // Solves the board loaded into root on pool. Every task runs its part of
+    // the tree in small node budgets; between budgets it hands the untried
+    // branches of its shallowest decision to idle workers (Search::split), so
+    // the tree is cut at shallow depths and stolen as workers run dry.
+    // The first task to find a solution stores it into board and cancels the rest.
+    // Every task adds its branches to progress and stops when it is cancelled,
+    // and collects its own statistics, merged into stats when it ends.
+    template <typename Mask>
+    bool parallel_solve(const Search<Mask>& root, parallel::WorkStealingPool& pool, Board& board,
+                        parallel::Progress* progress = nullptr, SearchStats* stats = nullptr)
+    {
+        using Status = typename Search<Mask>::Status;
+        constexpr long long budget = 256; // Branches between cancellation and split checks
+
+        std::atomic<bool> found{false};
+        std::mutex result_mutex;
+        parallel::TaskGroup group(pool);
+
+        std::function<void(std::shared_ptr<Search<Mask>>)> explore = [&](std::shared_ptr<Search<Mask>> search)
+        {
+            SearchStats local;
+            search->set_stats(stats ? &local : nullptr); // A split copy still points at its parent's
+            while (!found.load(std::memory_order_relaxed) && !(progress && progress->cancelled()))
+            {
+                long long before = search->get_nodes();
+                Status status = search->run(budget);
+                if (progress)
+                {
+                    progress->nodes.fetch_add(search->get_nodes() - before, std::memory_order_relaxed);
+                    progress->cells.store(search->get_filled(), std::memory_order_relaxed);
+                    parallel::watch_search(progress, *search, progress->nodes.load(std::memory_order_relaxed));
+                }
+                if (status == Status::Solved)
+                {
+                    std::lock_guard<std::mutex> lock(result_mutex);
+                    if (!found.exchange(true))
+                    {
+                        search->store(board);
+                    }
+                    break;
+                }
+                if (status == Status::Unsolvable)
+                {
+                    break;
+                }
+
+                if (pool.hungry())
+                {
+                    auto part = std::make_shared<Search<Mask>>(*search);
+                    if (search->split(*part))
+                    {
+                        group.run([&explore, part] { explore(part); });
+                    }
+                }
+            }
+            if (stats)
+            {
+                std::lock_guard<std::mutex> lock(result_mutex);
+                stats->merge(local);
+            }
+        };
+
+        group.run([&explore, &root] { explore(std::make_shared<Search<Mask>>(root)); });
+        group.wait();
+        return found;
+    }
+}
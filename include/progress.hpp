@@ -0,0 +1,28 @@
+#pragma once
+#include <atomic>
+
+namespace parallel
+{
+    class SearchWatch;
+
+    // Shared by a long job and whoever watches it. The job stores its counters
+    // and checks cancel between steps of work; the watcher reads the counters
+    // and sets cancel. Plain atomics, so neither side ever waits on the other.
+    struct Progress
+    {
+        std::atomic<bool> cancel{false};
+        std::atomic<long long> nodes{0}; // Search branches explored so far
+        std::atomic<int> cells{0}; // Filled cells of the search (solving) or clues removed (generating)
+        SearchWatch* watch = nullptr; // Set by the job before it starts to have its search followed (search_watch.hpp)
+
+        bool cancelled() const { return cancel.load(std::memory_order_relaxed); }
+
+        void reset()
+        {
+            cancel.store(false, std::memory_order_relaxed);
+            nodes.store(0, std::memory_order_relaxed);
+            cells.store(0, std::memory_order_relaxed);
+            watch = nullptr;
+        }
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "board.hpp"
+#include "puzzle_pool.hpp"
+
+// Pre-built puzzles with their solutions in one packed file, read through mmap.
+//
+// Layout, little endian:
+//   header   "SDKBANK1", uint32 group count, uint32 reserved (zero)
+//   index    one BankGroup per (size, level), sorted by size then level
+//   records  each group's records back to back from its offset. A record is the
+//            puzzle then the solution in row-major order, every cell
+//            bank_cell_bits(size) bits wide, least significant bit first,
+//            padded to a whole byte.
+namespace generator
+{
+    // Bits that hold 0 to size: 4 for 9x9, 5 for 16x16 and 25x25, 7 for 100x100
+    inline int bank_cell_bits(int size)
+    {
+        int bits = 1;
+        while ((1 << bits) <= size) ++bits;
+        return bits;
+    }
+
+    // Bytes of one record (puzzle and solution) of a size
+    inline std::size_t bank_record_bytes(int size)
+    {
+        return (2 * (std::size_t)size * size * bank_cell_bits(size) + 7) / 8;
+    }
+
+    // Index entry, read in place from the mapping
+    struct BankGroup
+    {
+        uint16_t size;
+        uint8_t level;
+        uint8_t bits;
+        uint32_t count;
+        uint64_t offset; // From the start of the file
+    };
+    static_assert(sizeof(BankGroup) == 16, "BankGroup is the on-disk index entry");
+
+    // Collects puzzles in memory and writes them out as a bank
+    class PuzzleBankWriter
+    {
+    public:
+        void add(int level, const Puzzle& puzzle); // Throws std::invalid_argument on a bad size or level
+        bool write(const std::string& path) const; // False if the file cannot be written
+        std::size_t size() const;
+
+    private:
+        struct Group
+        {
+            int size;
+            int level;
+            uint32_t count = 0;
+            std::vector<uint8_t> records;
+        };
+        std::vector<Group> groups;
+    };
+
+    // Read-only view of a bank file. Lookups decode straight from the mapping,
+    // nothing is read up front, and every method is safe to call from several
+    // threads once open.
+    class PuzzleBank
+    {
+    public:
+        PuzzleBank() = default;
+        ~PuzzleBank();
+        PuzzleBank(const PuzzleBank&) = delete;
+        PuzzleBank& operator=(const PuzzleBank&) = delete;
+
+        bool open(const std::string& path); // False if missing or malformed
+        void close();
+        bool is_open() const { return data != nullptr; }
+
+        std::size_t count(int size, int level) const;
+        // False if there is none or its record is corrupt: a cell past size, or a
+        // solution that breaks a row, column or box or changes a given. Whether
+        // the puzzle is unique is not checked, the writer's generator saw to that.
+        bool get(int size, int level, std::size_t index, Puzzle& puzzle) const;
+        bool take(int size, int level, Puzzle& puzzle); // A spread-out pick, false as with get
+
+    private:
+        const uint8_t* data = nullptr;
+        std::size_t length = 0;
+        const BankGroup* groups = nullptr;
+        uint32_t group_count = 0;
+        std::atomic<uint64_t> picks{0};
+
+        const BankGroup* find(int size, int level) const;
+    };
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include "board.hpp"
+
+namespace solver
+{
+    // Reads one puzzle line in the standard one-line format: n*n characters for
+    // boards up to 9x9 ('1'-'9', with '0' or '.' for an empty cell), or n*n numbers
+    // separated by commas or whitespace for any size. False when the line is malformed.
+    bool parse_puzzle(const std::string& line, Board& board);
+
+    // Writes board in the one-line format, compact characters when it fits in one digit
+    std::string format_puzzle(const Board& board);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "board.hpp"
+#include "rating.hpp"
+
+namespace generator
+{
+    // A generated puzzle with its unique solution
+    struct Puzzle
+    {
+        solver::Board puzzle;
+        solver::Board solution;
+        solver::Rating rating; // Techniques the puzzle needs, see generate_rated
+    };
+
+    // Keeps up to capacity puzzles ready for every level (1-5) of the warmed
+    // board sizes. Background threads refill the emptiest queue, the size
+    // warmed last first, so taking a puzzle is a queue pop and generation
+    // never runs on the caller's thread.
+    class PuzzlePool
+    {
+    public:
+        explicit PuzzlePool(int threads = 0, int capacity = 4); // 0 uses half of the hardware cores
+        ~PuzzlePool(); // Interrupts puzzles being generated and joins the threads
+
+        PuzzlePool(const PuzzlePool&) = delete;
+        PuzzlePool& operator=(const PuzzlePool&) = delete;
+
+        void warm(int size); // Starts keeping puzzles of this (valid) board size ready
+        bool try_take(int size, int level, Puzzle& out); // Pops a ready puzzle, false when its queue is empty
+        int ready(int size, int level); // Puzzles waiting for size and level
+
+    private:
+        static constexpr int levels = 5;
+
+        int capacity;
+        std::vector<std::deque<Puzzle>> queues; // Queue of (size, level) at size * levels + level - 1
+        std::vector<int> generating; // Puzzles being generated for each queue
+        std::vector<int> warmed; // Sizes to keep ready, in warm order
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::atomic<bool> stopping{false}; // Also the generators' stop flag
+        std::vector<std::thread> threads;
+
+        int pick_queue() const; // Emptiest queue below capacity, -1 when all are full
+        void worker_loop();
+    };
+}
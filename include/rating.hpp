@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "board.hpp"
+#include "solution_counter.hpp"
+
+#define MAX_RATING_SIZE 64 // Candidates are kept in one 64-bit mask per cell
+
+namespace solver
+{
+    // Logical techniques from easiest to hardest
+    enum class Technique
+    {
+        None, // Nothing to deduce, the board was already full
+        HiddenSingle,
+        NakedSingle,
+        LockedCandidates, // Pointing and claiming (box/line intersections)
+        Pair, // Naked and hidden pairs
+        Fish, // X-Wing and Swordfish
+        Chain, // Single-digit chains (simple colouring)
+        Search // The techniques stalled and guessing was needed
+    };
+
+    const char* technique_name(Technique technique);
+
+    struct Rating
+    {
+        Technique hardest = Technique::None; // Hardest technique the solve needed
+        int steps = 0; // Placements and eliminations made by the techniques
+        long long nodes = 0; // Search branches after the techniques stalled
+        int solutions = 0; // 0, 1 or 2 (two or more); -1 when the rating gave up early
+    };
+
+    // Rates a puzzle by solving it the way a person would: the easiest technique
+    // that still makes progress is applied, then it starts over from the easiest
+    // one. When none of them helps the rest is left to the search, whose branch
+    // count is recorded as the effort. A puzzle the techniques solve alone has
+    // exactly one solution, so rating doubles as a uniqueness check.
+    class Rater
+    {
+    public:
+        explicit Rater(int size); // Size at most MAX_RATING_SIZE
+
+        // Stops as soon as a technique harder than limit would be needed, hardest
+        // is then the next technique and solutions -1. The search after a stall
+        // gives up (solutions -1) past max_nodes branches, 0 means no cap.
+        Rating rate(const Board& puzzle, Technique limit = Technique::Search, long long max_nodes = 0);
+
+    private:
+        int size;
+        int subgrid_size;
+        std::uint64_t full; // The lowest size bits, one per digit
+
+        std::vector<std::uint64_t> cand; // Candidates of every empty cell, 0 once it is filled
+        std::vector<std::uint8_t> value; // Row-major cell values, same layout as Board
+        std::vector<int> units; // 3 * size units of size cells: rows, then columns, then subgrids
+        std::vector<int> cell_units; // The row, column and subgrid unit of every cell
+        std::vector<int> color; // Scratch of the colouring, per cell
+        std::vector<int> queue; // Scratch of the colouring, cells to visit
+        int empty = 0;
+        std::unique_ptr<SolutionCounter> counter; // Search after a stall
+        Board stalled; // Board handed to the counter
+
+        // Each technique returns the number of placements or eliminations it made,
+        // -1 when it ran into a contradiction
+        int hidden_singles();
+        int naked_singles();
+        int locked_candidates();
+        int pairs();
+        int fish();
+        int chains();
+
+        bool place(int cell, int index); // False when index is no longer a candidate of cell
+        int eliminate(int cell, std::uint64_t mask); // Removes mask from the candidates of cell, 1 when that changed them
+        bool sees(int a, int b) const; // a and b share a row, column or subgrid
+        int fish_lines(int index, int first_unit, int cover_unit); // X-Wing and Swordfish on rows or on columns
+    };
+}
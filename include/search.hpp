@@ -0,0 +1,437 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "board.hpp"
+#include "bitmask.hpp"
+#include "search_stats.hpp"
+
+namespace solver
+{
+    // Propagating search engine: after every placement naked and hidden singles
+    // are applied until nothing changes, then it branches on the empty cell with
+    // the fewest candidates (MRV). Constraints are kept in seen_row/seen_col/
+    // seen_subgrid bitmasks, cells map to subgrids through Game's subgrid_lut.
+    //
+    // The search is iterative: an explicit stack of decisions and a trail of
+    // placements, both preallocated to n*n entries, so there is no recursion and
+    // no heap allocation per node. run() can stop after a node budget and resume.
+    template <typename Mask>
+    class Search
+    {
+    public:
+        enum class Status { Running, Solved, Unsolvable };
+
+        Search(int size, const SubgridLut& subgrid_lut) :
+            size(size),
+            subgrid_size(1),
+            full(bitmask::low<Mask>(size)),
+            subgrid_lut(&subgrid_lut),
+            value(size * size, 0),
+            trail(size * size),
+            stack(size * size)
+        {
+            while (subgrid_size * subgrid_size < size) ++subgrid_size;
+        }
+
+        // Places the givens of board, false if two of them conflict
+        bool load(const Board& board)
+        {
+            std::fill(value.begin(), value.end(), 0);
+            std::fill(seen_row, seen_row + size, Mask(0));
+            std::fill(seen_col, seen_col + size, Mask(0));
+            std::fill(seen_subgrid, seen_subgrid + size, Mask(0));
+            trail_size = 0;
+            depth = 0;
+            empty = size * size;
+            nodes = 0;
+            pending = true;
+            status = Status::Running;
+
+            const std::uint8_t* cells = board.data();
+            for (int cell = 0; cell < size * size; ++cell)
+            {
+                int num = cells[cell];
+                if (num == 0) continue;
+
+                if (!bitmask::any(candidates(cell / size, cell % size) & bitmask::bit<Mask>(num - 1)))
+                {
+                    return false;
+                }
+                place(cell, num - 1);
+            }
+            trail_size = 0; // Givens are never undone
+            return true;
+        }
+
+        bool solve()
+        {
+            while (run(1 << 20) == Status::Running)
+            {
+            }
+            return status == Status::Solved;
+        }
+
+        // Searches until a solution is found, the tree is exhausted or about
+        // budget more branches were taken. Calling it again resumes the search,
+        // after a solution it goes on to the next one.
+        Status run(long long budget)
+        {
+            if (status == Status::Solved)
+            {
+                status = Status::Running; // Look for the next solution
+            }
+            if (status != Status::Running)
+            {
+                return status;
+            }
+
+            long long stop = nodes + budget;
+            while (true)
+            {
+                if (pending)
+                {
+                    // Entering a node: propagate, then open a decision on the MRV cell
+                    pending = false;
+#if SEARCH_STATS
+                    int forced_from = trail_size;
+                    bool consistent = propagate();
+                    if (stats)
+                    {
+                        stats->forced += trail_size - forced_from;
+                        if (!consistent) ++stats->backtracks;
+                    }
+                    if (consistent)
+#else
+                    if (propagate())
+#endif
+                    {
+                        Frame& frame = stack[depth];
+                        frame.mark = trail_size;
+                        frame.cell = choose_cell(frame.options);
+                        if (frame.cell == -1)
+                        {
+                            status = Status::Solved;
+                            return status;
+                        }
+                        ++depth;
+                    }
+                }
+
+                // Take the next branch of the deepest open decision
+                while (depth > 0)
+                {
+                    Frame& frame = stack[depth - 1];
+                    undo(frame.mark);
+                    if (bitmask::any(frame.options))
+                    {
+                        int index = bitmask::ctz(frame.options);
+                        frame.options = bitmask::clear_lowest(frame.options);
+                        ++nodes;
+#if SEARCH_STATS
+                        if (stats) stats->branch(depth - 1);
+#endif
+                        place(frame.cell, index);
+                        pending = true;
+                        break;
+                    }
+#if SEARCH_STATS
+                    if (stats) ++stats->backtracks; // The decision is out of branches
+#endif
+                    --depth;
+                }
+
+                if (!pending)
+                {
+                    status = Status::Unsolvable;
+                    return status;
+                }
+                if (nodes >= stop)
+                {
+                    return status;
+                }
+            }
+        }
+
+        // Moves the untried branches of the shallowest open decision into out,
+        // which then explores exactly those while this search keeps the rest.
+        // False when no decision has branches left to give away.
+        bool split(Search& out)
+        {
+            int shallowest = 0;
+            while (shallowest < depth && !bitmask::any(stack[shallowest].options))
+            {
+                ++shallowest;
+            }
+            if (shallowest == depth)
+            {
+                return false;
+            }
+
+            out = *this;
+            for (int i = 0; i < shallowest; ++i)
+            {
+                out.stack[i].options = Mask(0);
+            }
+            out.depth = shallowest + 1; // out resumes by taking the next branch of that decision
+            out.pending = false;
+            stack[shallowest].options = Mask(0);
+            return true;
+        }
+
+        // Number of solutions of the loaded puzzle, counting stops at limit.
+        // -1 when more than max_nodes branches were needed (0 means no cap).
+        int count_solutions(int limit, long long max_nodes = 0)
+        {
+            reset();
+            long long budget = max_nodes > 0 ? max_nodes : 1 << 20;
+            int count = 0;
+            while (count < limit)
+            {
+                Status result = run(max_nodes > 0 ? budget - nodes : budget);
+                if (result == Status::Solved)
+                {
+                    ++count;
+                }
+                else if (result == Status::Unsolvable)
+                {
+                    break;
+                }
+                else if (max_nodes > 0)
+                {
+                    return -1;
+                }
+            }
+            return count;
+        }
+
+        // Drops every decision and propagated value, back to the givens alone
+        void reset()
+        {
+            undo(0);
+            depth = 0;
+            nodes = 0;
+            pending = true;
+            status = Status::Running;
+        }
+
+        // Edits the givens in place (after a reset), so checking many variants
+        // of one puzzle needs no reload
+        void remove_given(int cell)
+        {
+            reset();
+            unplace(cell);
+        }
+
+        // False, leaving the givens unchanged, when num conflicts with them
+        bool add_given(int cell, int num)
+        {
+            reset();
+            if (!bitmask::any(candidates(cell / size, cell % size) & bitmask::bit<Mask>(num - 1)))
+            {
+                return false;
+            }
+            place(cell, num - 1);
+            trail_size = 0; // Givens are never undone
+            return true;
+        }
+
+        Status get_status() const { return status; }
+        int get_depth() const { return depth; } // Open decisions on the stack
+        int get_cell() const { return depth ? stack[depth - 1].cell : -1; } // Cell of the deepest open decision
+        int get_size() const { return size; }
+
+        // Copies the current values into board
+        void store(Board& board) const
+        {
+            std::copy(value.begin(), value.end(), board.data());
+        }
+
+        void set_stats(SearchStats* report) { stats = report; } // Filled from the next run on, nullptr stops it; copies share it
+        long long get_nodes() const { return nodes; } // Branches taken during the last solve
+        int get_filled() const { return (int)std::count_if(value.begin(), value.end(), [](std::uint8_t v) { return v != 0; }); } // Givens and placed cells
+
+    private:
+        int size;
+        int subgrid_size;
+        Mask full; // The lowest size bits, one per digit
+        const SubgridLut* subgrid_lut;
+
+        std::vector<std::uint8_t> value; // Row-major cell values, 0 when empty (same layout as Board)
+        Mask seen_row[MAX_BOARD_SIZE];
+        Mask seen_col[MAX_BOARD_SIZE];
+        Mask seen_subgrid[MAX_BOARD_SIZE];
+        // One branching decision: the cell, its untried candidates and the trail size before it
+        struct Frame
+        {
+            int cell;
+            Mask options;
+            int mark;
+        };
+
+        std::vector<int> trail; // Cells placed since the givens, in order, for undoing
+        int trail_size = 0;
+        std::vector<Frame> stack; // Open decisions, at most one per cell
+        int depth = 0;
+        bool pending = true; // A placement still has to be propagated
+        Status status = Status::Running;
+        int empty = 0; // Number of empty cells
+        long long nodes = 0;
+        SearchStats* stats = nullptr;
+
+        Mask candidates(int row, int col) const
+        {
+            return ~(seen_row[row] | seen_col[col] | seen_subgrid[(*subgrid_lut)[row][col]]) & full;
+        }
+
+        void place(int cell, int index)
+        {
+            int row = cell / size;
+            int col = cell % size;
+            Mask index_mask = bitmask::bit<Mask>(index);
+
+            value[cell] = index + 1;
+            seen_row[row] |= index_mask;
+            seen_col[col] |= index_mask;
+            seen_subgrid[(*subgrid_lut)[row][col]] |= index_mask;
+            trail[trail_size++] = cell;
+            --empty;
+        }
+
+        // Removes every placement made after the trail had mark entries
+        void undo(int mark)
+        {
+            while (trail_size > mark)
+            {
+                unplace(trail[--trail_size]);
+            }
+        }
+
+        void unplace(int cell)
+        {
+            int row = cell / size;
+            int col = cell % size;
+            Mask index_mask = ~bitmask::bit<Mask>(value[cell] - 1);
+
+            value[cell] = 0;
+            seen_row[row] &= index_mask;
+            seen_col[col] &= index_mask;
+            seen_subgrid[(*subgrid_lut)[row][col]] &= index_mask;
+            ++empty;
+        }
+
+        // Places naked singles, false when an empty cell has no candidate left
+        bool naked_singles(bool& changed)
+        {
+            for (int cell = 0; cell < size * size; ++cell)
+            {
+                if (value[cell] != 0) continue;
+
+                Mask options = candidates(cell / size, cell % size);
+                if (!bitmask::any(options))
+                {
+                    return false;
+                }
+                if (!bitmask::any(bitmask::clear_lowest(options)))
+                {
+                    place(cell, bitmask::ctz(options));
+                    changed = true;
+                }
+            }
+            return true;
+        }
+
+        // Places hidden singles of one unit (row, column or subgrid) given its cells,
+        // false when a missing digit has no cell left in the unit
+        bool hidden_singles(const int* cells, Mask seen, bool& changed)
+        {
+            Mask once = Mask(0);
+            Mask twice = Mask(0);
+            for (int i = 0; i < size; ++i)
+            {
+                int cell = cells[i];
+                if (value[cell] != 0) continue;
+
+                Mask options = candidates(cell / size, cell % size);
+                twice |= once & options;
+                once |= options;
+            }
+
+            if (once != (full & ~seen))
+            {
+                return false;
+            }
+
+            Mask hidden = once & ~twice;
+            while (bitmask::any(hidden))
+            {
+                int index = bitmask::ctz(hidden);
+                Mask index_mask = bitmask::bit<Mask>(index);
+                for (int i = 0; i < size; ++i)
+                {
+                    int cell = cells[i];
+                    if (value[cell] != 0 || !bitmask::any(candidates(cell / size, cell % size) & index_mask)) continue;
+
+                    place(cell, index);
+                    changed = true;
+                    break;
+                }
+                hidden = bitmask::clear_lowest(hidden);
+            }
+            return true;
+        }
+
+        // Applies naked and hidden singles to a fixpoint, false on a contradiction
+        bool propagate()
+        {
+            int box = subgrid_size;
+            int unit[MAX_BOARD_SIZE];
+            bool changed = true;
+            while (changed && empty > 0)
+            {
+                changed = false;
+                if (!naked_singles(changed))
+                {
+                    return false;
+                }
+                if (changed) continue; // Cheap rule first, hidden singles only when it stalls
+
+                for (int u = 0; u < size && !changed; ++u)
+                {
+                    for (int i = 0; i < size; ++i) unit[i] = u * size + i;
+                    if (!hidden_singles(unit, seen_row[u], changed)) return false;
+
+                    for (int i = 0; i < size; ++i) unit[i] = i * size + u;
+                    if (!hidden_singles(unit, seen_col[u], changed)) return false;
+
+                    int top = (u / box) * box;
+                    int left = (u % box) * box;
+                    for (int i = 0; i < size; ++i) unit[i] = (top + i / box) * size + left + i % box;
+                    if (!hidden_singles(unit, seen_subgrid[u], changed)) return false;
+                }
+            }
+            return true;
+        }
+
+        // Empty cell with the fewest candidates, -1 when the board is full
+        int choose_cell(Mask& options) const
+        {
+            int best = -1;
+            int best_count = size + 1;
+            for (int cell = 0; cell < size * size && best_count > 2; ++cell)
+            {
+                if (value[cell] != 0) continue;
+
+                Mask cell_options = candidates(cell / size, cell % size);
+                int count = bitmask::popcount(cell_options);
+                if (count < best_count)
+                {
+                    best = cell;
+                    best_count = count;
+                    options = cell_options;
+                }
+            }
+            return best;
+        }
+    };
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Statistics collection is compiled in unless SEARCH_STATS is 0, which the
+// release build sets (make RELEASE=1). Compiled out, SearchStats stays in the
+// API but no engine touches it, so passing one costs nothing and it stays empty.
+#ifndef SEARCH_STATS
+#define SEARCH_STATS 1
+#endif
+
+namespace solver
+{
+    // What a search did, filled by whichever engine ran (bitplane9, the
+    // propagating Search or Dancing Links) when a pointer to it is passed in.
+    struct SearchStats
+    {
+        static constexpr bool enabled = SEARCH_STATS != 0;
+
+        long long nodes = 0; // Branches taken
+        long long backtracks = 0; // Decision levels stepped back from: a node that hit a contradiction or a decision out of branches
+        long long forced = 0; // Cells filled by propagation rather than a branch; Dancing Links has none and leaves it 0
+        long long rows_covered = 0; // Dancing Links only: matrix rows unlinked by cover, every re-cover after a backtrack included
+        int max_depth = 0; // Most decisions open at once
+        double wall_ms = 0; // Set by solver::solve
+        std::vector<long long> branches; // Branches taken at each decision depth, [0] is the first decision
+
+        void branch(int depth) // A branch taken at depth
+        {
+            ++nodes;
+            if ((int)branches.size() <= depth) branches.resize(depth + 1, 0);
+            ++branches[depth];
+            if (depth + 1 > max_depth) max_depth = depth + 1;
+        }
+
+        void merge(const SearchStats& other); // Adds the counts of other, for searches split over threads
+        void clear();
+        std::string to_json() const; // One line JSON object
+    };
+}
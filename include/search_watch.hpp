@@ -0,0 +1,137 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include "board.hpp"
+#include "progress.hpp"
+
+namespace parallel
+{
+    // Bounded single-producer/single-consumer queue over preallocated slots.
+    // The producer fills the slot claim hands out and publishes it; the
+    // consumer swaps the newest published slot out and drops the older ones.
+    // Neither side ever waits: a full ring makes claim return nullptr.
+    template <typename T, std::size_t Capacity>
+    class SpscRing
+    {
+        static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "Capacity is a power of two");
+
+    public:
+        // Producer
+        T* claim()
+        {
+            std::size_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) == Capacity)
+            {
+                return nullptr;
+            }
+            return &slots[h & (Capacity - 1)];
+        }
+
+        void publish()
+        {
+            head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // Consumer: swaps the newest value into out, false when nothing new was published
+        bool take_latest(T& out)
+        {
+            std::size_t h = head.load(std::memory_order_acquire);
+            if (h == tail.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            std::swap(out, slots[(h - 1) & (Capacity - 1)]);
+            tail.store(h, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::array<T, Capacity> slots;
+        alignas(64) std::atomic<std::size_t> head{0}; // Published so far, written by the producer
+        alignas(64) std::atomic<std::size_t> tail{0}; // Consumed so far, written by the consumer
+    };
+
+    // A moment of a running search: its board (givens and current placements),
+    // the cell of its deepest decision and how deep it is
+    struct SearchSnapshot
+    {
+        solver::Board board;
+        int cell = -1; // Row-major, -1 when no decision is open
+        int depth = 0;
+        long long nodes = 0;
+    };
+
+    // Lets a view follow a search from another thread. The search offers a
+    // snapshot between node budgets; at most one is taken per interval, and
+    // only when no other search thread is publishing and the view has room,
+    // so offering costs a clock read and never blocks. Several search threads
+    // may offer (parallel_solve), exactly one thread takes.
+    class SearchWatch
+    {
+    public:
+        explicit SearchWatch(int interval_ms = 40) :
+            interval(std::chrono::milliseconds(interval_ms))
+        {
+        }
+
+        // Search side: a snapshot to fill and hand to end, or nullptr when none is wanted now
+        SearchSnapshot* begin()
+        {
+            auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+            if (now < next.load(std::memory_order_relaxed) || publishing.exchange(true, std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            SearchSnapshot* snapshot = ring.claim();
+            if (!snapshot)
+            {
+                publishing.store(false, std::memory_order_release); // The view is behind, skip this one
+                return nullptr;
+            }
+            next.store(now + interval.count(), std::memory_order_relaxed);
+            return snapshot;
+        }
+
+        void end()
+        {
+            ring.publish();
+            publishing.store(false, std::memory_order_release);
+        }
+
+        // View side: the newest snapshot since the last call, false if there is none
+        bool take_latest(SearchSnapshot& out) { return ring.take_latest(out); }
+
+    private:
+        SpscRing<SearchSnapshot, 4> ring;
+        std::chrono::steady_clock::duration interval;
+        std::atomic<std::chrono::steady_clock::rep> next{0}; // Earliest time of the next snapshot
+        std::atomic<bool> publishing{false};
+    };
+
+    // Offers a snapshot of engine (Search or DancingLinks) to progress's watch, if it has one
+    template <typename Engine>
+    void watch_search(Progress* progress, const Engine& engine, long long nodes)
+    {
+        if (!progress || !progress->watch)
+        {
+            return;
+        }
+        SearchSnapshot* snapshot = progress->watch->begin();
+        if (!snapshot)
+        {
+            return;
+        }
+        if ((int)snapshot->board.size() != engine.get_size())
+        {
+            snapshot->board.assign(engine.get_size()); // Only for the first snapshots of a size
+        }
+        engine.store(snapshot->board);
+        snapshot->cell = engine.get_cell();
+        snapshot->depth = engine.get_depth();
+        snapshot->nodes = nodes;
+        progress->watch->end();
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <memory>
+#include "board.hpp"
+
+namespace solver
+{
+    // Counts the solutions of a puzzle up to a limit, for uniqueness checks.
+    // Givens can be removed and put back one at a time between counts, so a
+    // generator trying clue removals never copies or reloads the board.
+    class SolutionCounter
+    {
+    public:
+        virtual ~SolutionCounter() = default;
+
+        virtual bool load(const Board& board) = 0; // False if two givens conflict
+        virtual void remove_given(int cell) = 0;
+        virtual bool add_given(int cell, int num) = 0; // False if num conflicts with the givens
+        virtual int count(int limit, long long max_nodes = 0) = 0; // Solutions found up to limit, -1 past max_nodes branches (0: no cap)
+        virtual long long get_nodes() const = 0; // Branches taken by the last count
+    };
+
+    // Counter on the propagating search with the mask type fitting size,
+    // all its state is allocated here once
+    std::unique_ptr<SolutionCounter> make_solution_counter(int size);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "board.hpp"
+#include "thread_pool.hpp"
+#include "progress.hpp"
+#include "search_stats.hpp"
+
+#define MAX_PROPAGATION_SIZE 81 // Bigger boards are solved with Dancing Links, faster than 128-bit masks at 100x100 (see sudoku-bench grid_big)
+#define PARALLEL_SOLVE_SIZE 16 // Boards from this size up are searched on all cores
+
+namespace solver
+{
+    enum class Result
+    {
+        Solved,
+        Invalid, // Two givens conflict
+        Unsolvable,
+        Cancelled // Stopped through Progress::cancel before an answer
+    };
+
+    // Solves board in place with the engine suited to its size: the digit-plane
+    // kernel for 9x9, the propagating bitmask search (on all cores of pool when
+    // given and the board is big enough) or Dancing Links above MAX_PROPAGATION_SIZE.
+    // With progress, the engines report into it every few thousand branches
+    // and return Result::Cancelled soon after its cancel flag is set.
+    // With stats, whichever engine runs adds what it did to it (see search_stats.hpp).
+    Result solve(Board& board, int subgrid_size, const SubgridLut& subgrid_lut, parallel::WorkStealingPool* pool = nullptr,
+                 parallel::Progress* progress = nullptr, SearchStats* stats = nullptr);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+namespace parallel
+{
+    // Fixed set of worker threads, each with its own task deque.
+    // A worker pops its newest task first and, when its deque is empty,
+    // steals the oldest task of another worker (older tasks are usually
+    // bigger parts of a search tree).
+    class WorkStealingPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        explicit WorkStealingPool(int threads = 0); // 0 uses one thread per hardware core
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        void submit(Task task); // Called from a worker it goes to that worker's deque, else round robin
+        int size() const { return (int)threads.size(); }
+        bool hungry() const; // Some worker is idle and no task is waiting
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread> threads;
+
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        std::atomic<int> queued{0}; // Tasks waiting in all deques
+        std::atomic<int> idle{0}; // Workers sleeping on wake
+        std::atomic<unsigned> next_worker{0};
+        bool stopping = false;
+
+        static thread_local const WorkStealingPool* current_pool; // Pool of the calling worker thread
+        static thread_local int current_index;
+
+        bool pop(int index, Task& task); // Own deque first, then steal
+        void worker_loop(int index);
+    };
+
+    // Tracks a set of tasks submitted to a pool so the caller can wait for
+    // just those, while the pool keeps serving other work.
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(WorkStealingPool& pool) : pool(pool) {}
+        ~TaskGroup() { wait(); }
+
+        void run(WorkStealingPool::Task task);
+        void wait();
+
+    private:
+        WorkStealingPool& pool;
+        std::mutex mutex;
+        std::condition_variable done;
+        int pending = 0;
+    };
+}
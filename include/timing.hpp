@@ -0,0 +1,74 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace timing
+{
+    // Nearest-rank percentile of values, p in [0, 100], 0 when empty. Takes a
+    // copy to partially sort, so callers keep their order.
+    double percentile(std::vector<double> values, double p);
+
+    // The last capacity samples in a ring, with percentiles over them. Meant
+    // for per-frame numbers: add is a store, the sorting happens in percentile.
+    class Histogram
+    {
+    public:
+        explicit Histogram(std::size_t capacity = 256);
+
+        void add(double value);
+        void clear();
+
+        std::size_t count() const { return filled; }
+        double last() const { return latest; }
+        double max() const;
+        double percentile(double p) const; // p in [0, 100], 0 when empty
+
+    private:
+        std::vector<double> samples;
+        std::size_t next = 0;
+        std::size_t filled = 0;
+        double latest = 0;
+    };
+
+    // Milliseconds since it was started
+    class Stopwatch
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        Stopwatch() : start(Clock::now()) {}
+
+        void restart() { start = Clock::now(); }
+        double elapsed_ms() const { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); }
+
+    private:
+        Clock::time_point start;
+    };
+
+    // Adds the milliseconds of its scope to a histogram. Given nullptr it does
+    // nothing, not even read the clock, which is how timing is switched off.
+    class ScopedTimer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit ScopedTimer(Histogram* histogram) :
+            histogram(histogram)
+        {
+            if (histogram) start = Clock::now();
+        }
+
+        ~ScopedTimer()
+        {
+            if (histogram) histogram->add(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Histogram* histogram;
+        Clock::time_point start;
+    };
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+namespace generator
+{
+    // xoshiro256** (Blackman and Vigna): 32 bytes of state, a few cycles per
+    // number, and the same sequence for a seed on every platform. Meets
+    // UniformRandomBitGenerator, though below and shuffle keep the output
+    // independent of the standard library.
+    class Xoshiro256
+    {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit Xoshiro256(std::uint64_t seed = 0) { reseed(seed); }
+
+        // The state is expanded from the seed with splitmix64, so nearby seeds
+        // give unrelated sequences and no seed gives the all-zero state
+        void reseed(std::uint64_t seed)
+        {
+            for (auto& word : state)
+            {
+                seed += 0x9e3779b97f4a7c15ULL;
+                std::uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()()
+        {
+            std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+            std::uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+            return result;
+        }
+
+        // Uniform in [0, bound) by Lemire's multiply-shift with rejection
+        std::uint32_t below(std::uint32_t bound)
+        {
+            std::uint64_t product = (std::uint64_t)(std::uint32_t)((*this)() >> 32) * bound;
+            if ((std::uint32_t)product < bound)
+            {
+                std::uint32_t threshold = -bound % bound;
+                while ((std::uint32_t)product < threshold)
+                {
+                    product = (std::uint64_t)(std::uint32_t)((*this)() >> 32) * bound;
+                }
+            }
+            return (std::uint32_t)(product >> 32);
+        }
+
+        // Fisher-Yates over [first, last)
+        template <typename It>
+        void shuffle(It first, It last)
+        {
+            for (auto n = last - first; n > 1; --n)
+            {
+                auto j = below((std::uint32_t)n);
+                auto tmp = first[n - 1];
+                first[n - 1] = first[j];
+                first[j] = tmp;
+            }
+        }
+
+    private:
+        std::uint64_t state[4];
+
+        static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    };
+}
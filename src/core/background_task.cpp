@@ -0,0 +1,51 @@
+#include "background_task.hpp"
+
+namespace parallel
+{
+    BackgroundTask::~BackgroundTask()
+    {
+        cancel();
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    bool BackgroundTask::start(Job job)
+    {
+        if (busy.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        if (thread.joinable())
+        {
+            thread.join(); // Finished but never taken
+        }
+
+        state.reset();
+        finished.store(false, std::memory_order_relaxed);
+        busy.store(true, std::memory_order_relaxed);
+        thread = std::thread([this, job = std::move(job)]
+        {
+            job(state);
+            finished.store(true, std::memory_order_release);
+            busy.store(false, std::memory_order_release);
+        });
+        return true;
+    }
+
+    void BackgroundTask::cancel()
+    {
+        state.cancel.store(true, std::memory_order_relaxed);
+    }
+
+    bool BackgroundTask::take_finished()
+    {
+        if (!finished.exchange(false, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+        thread.join(); // The job has returned, so this only reaps the thread
+        return true;
+    }
+}
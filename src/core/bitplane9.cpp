@@ -0,0 +1,66 @@
+#include "bitplane9.hpp"
+#include "bitplane9_kernel.hpp"
+
+namespace solver
+{
+    namespace
+    {
+        // Portable plane operations, one word at a time
+        struct ScalarOps
+        {
+            // Removes cells (one word per band) from every digit plane
+            static void clear_cells(std::uint32_t* cand, const std::uint32_t* cells)
+            {
+                for (int d = 0; d < 9; ++d)
+                {
+                    for (int b = 0; b < 3; ++b) cand[d * 4 + b] &= ~cells[b];
+                }
+            }
+
+            // Cells with at least one, two and three candidates, per band
+            static void count(const std::uint32_t* cand, std::uint32_t* ones, std::uint32_t* twos, std::uint32_t* threes)
+            {
+                for (int b = 0; b < 4; ++b)
+                {
+                    std::uint32_t one = 0, two = 0, three = 0;
+                    for (int d = 0; d < 9; ++d)
+                    {
+                        std::uint32_t plane = cand[d * 4 + b];
+                        three |= two & plane;
+                        two |= one & plane;
+                        one |= plane;
+                    }
+                    ones[b] = one;
+                    twos[b] = two;
+                    threes[b] = three;
+                }
+            }
+        };
+
+        bool has_avx2()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            static const bool avx2 = __builtin_cpu_supports("avx2");
+            return avx2;
+#else
+            return false;
+#endif
+        }
+    }
+
+    Result solve_bitplane9(Board& board, long long* nodes, SearchStats* stats)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        if (has_avx2())
+        {
+            return solve_bitplane9_avx2(board, nodes, stats);
+        }
+#endif
+        return solve_planes<ScalarOps>(board, nodes, stats);
+    }
+
+    const char* bitplane9_isa()
+    {
+        return has_avx2() ? "avx2" : "scalar";
+    }
+}
@@ -0,0 +1,71 @@
+// AVX2 build of the 9x9 digit-plane kernel. Only this file is compiled for
+// AVX2 (through the target pragma, the rest of the program keeps the baseline
+// instruction set) and solve_bitplane9 calls it only after checking the CPU.
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cstdint>
+#include <immintrin.h>
+#include "board.hpp"
+#include "solve.hpp"
+
+// Headers above stay baseline code, everything defined below may use AVX2
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt,bmi")
+
+#include "bitplane9_kernel.hpp"
+
+namespace solver
+{
+    namespace
+    {
+        // The 40 plane words (9 digits and a padding digit, 4 words each) are
+        // five 256-bit registers holding two digits apiece
+        struct Avx2Ops
+        {
+            static void clear_cells(std::uint32_t* cand, const std::uint32_t* cells)
+            {
+                __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)cells));
+                for (int i = 0; i < 40; i += 8)
+                {
+                    __m256i* planes = (__m256i*)(cand + i);
+                    _mm256_store_si256(planes, _mm256_andnot_si256(mask, _mm256_load_si256(planes)));
+                }
+            }
+
+            static void count(const std::uint32_t* cand, std::uint32_t* ones, std::uint32_t* twos, std::uint32_t* threes)
+            {
+                __m256i one = _mm256_setzero_si256();
+                __m256i two = one;
+                __m256i three = one;
+                for (int i = 0; i < 40; i += 8)
+                {
+                    __m256i planes = _mm256_load_si256((const __m256i*)(cand + i));
+                    three = _mm256_or_si256(three, _mm256_and_si256(two, planes));
+                    two = _mm256_or_si256(two, _mm256_and_si256(one, planes));
+                    one = _mm256_or_si256(one, planes);
+                }
+
+                // Merge the counters of the even and odd digits held in the two halves
+                __m128i one_lo = _mm256_castsi256_si128(one), one_hi = _mm256_extracti128_si256(one, 1);
+                __m128i two_lo = _mm256_castsi256_si128(two), two_hi = _mm256_extracti128_si256(two, 1);
+                __m128i three_lo = _mm256_castsi256_si128(three), three_hi = _mm256_extracti128_si256(three, 1);
+
+                __m128i merged_three = _mm_or_si128(_mm_or_si128(three_lo, three_hi),
+                                                    _mm_or_si128(_mm_and_si128(two_lo, one_hi), _mm_and_si128(one_lo, two_hi)));
+                __m128i merged_two = _mm_or_si128(_mm_or_si128(two_lo, two_hi), _mm_and_si128(one_lo, one_hi));
+                _mm_storeu_si128((__m128i*)ones, _mm_or_si128(one_lo, one_hi));
+                _mm_storeu_si128((__m128i*)twos, merged_two);
+                _mm_storeu_si128((__m128i*)threes, merged_three);
+            }
+        };
+    }
+
+    Result solve_bitplane9_avx2(Board& board, long long* nodes, SearchStats* stats)
+    {
+        return solve_planes<Avx2Ops>(board, nodes, stats);
+    }
+}
+
+#pragma GCC pop_options
+
+#endif
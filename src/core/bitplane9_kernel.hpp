@@ -0,0 +1,285 @@
+#pragma once
+#include <cstdint>
+#include "board.hpp"
+#include "solve.hpp"
+#include "search_stats.hpp"
+
+// The 9x9 digit-plane search, written once against an Ops policy that holds
+// the operations touching all nine planes at once. bitplane9.cpp instantiates
+// it with portable scalar Ops and bitplane9_avx2.cpp with AVX2 intrinsics.
+// Everything below lives in an unnamed namespace or depends on Ops, so the two
+// translation units, built for different instruction sets, never share code.
+namespace solver
+{
+    Result solve_bitplane9_avx2(Board& board, long long* nodes, SearchStats* stats); // Defined in bitplane9_avx2.cpp on x86
+
+    namespace
+    {
+        // Cell (row r of the band, column c) is bit r * 9 + c of its band word
+        constexpr std::uint32_t band_full = (1u << 27) - 1;
+        constexpr std::uint32_t row_bits = 0x1ff; // Top row of a band
+        constexpr std::uint32_t col_bits = 1u | 1u << 9 | 1u << 18; // Leftmost column of a band
+        constexpr std::uint32_t box_bits = 7u | 7u << 9 | 7u << 18; // Leftmost box of a band
+
+        struct Planes
+        {
+            alignas(32) std::uint32_t cand[40]; // [digit][band] cells where the digit can go; band 3 and digit 9 are zero padding
+            std::uint32_t placed[36]; // [digit][band] cells holding the digit
+            std::uint32_t unsolved[4]; // Empty cells of each band
+            std::uint8_t value[81]; // Row-major cell values, same layout as Board
+        };
+
+        inline bool single_bit(std::uint32_t m) { return m && !(m & (m - 1)); }
+
+        template <typename Ops>
+        void place(Planes& p, int digit, int band, int i)
+        {
+            std::uint32_t bit = 1u << i;
+            int r = i / 9;
+            int c = i % 9;
+
+            p.value[(band * 3 + r) * 9 + c] = digit + 1;
+            p.unsolved[band] &= ~bit;
+            p.placed[digit * 4 + band] |= bit;
+
+            // The cell leaves every plane, the digit leaves its row, box and column
+            std::uint32_t cells[4] = { 0, 0, 0, 0 };
+            cells[band] = bit;
+            Ops::clear_cells(p.cand, cells);
+
+            std::uint32_t* plane = p.cand + digit * 4;
+            plane[band] &= ~(row_bits << (r * 9) | box_bits << (c / 3 * 3));
+            std::uint32_t col = ~(col_bits << c);
+            plane[0] &= col;
+            plane[1] &= col;
+            plane[2] &= col;
+        }
+
+        // Digits with a single place left in a row, column or box; false when a
+        // digit missing from a unit has no place left in it
+        template <typename Ops>
+        bool hidden_singles(Planes& p, bool& changed)
+        {
+            for (int d = 0; d < 9; ++d)
+            {
+                const std::uint32_t* plane = p.cand + d * 4;
+                const std::uint32_t* placed = p.placed + d * 4;
+
+                for (int b = 0; b < 3; ++b)
+                {
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        std::uint32_t row = row_bits << (k * 9);
+                        if (!(placed[b] & row))
+                        {
+                            std::uint32_t options = plane[b] & row;
+                            if (!options) return false;
+                            if (single_bit(options))
+                            {
+                                place<Ops>(p, d, b, __builtin_ctz(options));
+                                changed = true;
+                            }
+                        }
+
+                        std::uint32_t box = box_bits << (k * 3);
+                        if (!(placed[b] & box))
+                        {
+                            std::uint32_t options = plane[b] & box;
+                            if (!options) return false;
+                            if (single_bit(options))
+                            {
+                                place<Ops>(p, d, b, __builtin_ctz(options));
+                                changed = true;
+                            }
+                        }
+                    }
+                }
+
+                std::uint32_t any_placed = placed[0] | placed[1] | placed[2];
+                for (int c = 0; c < 9; ++c)
+                {
+                    if (any_placed & col_bits << c) continue;
+
+                    // The column's 9 cells folded into one word: bit r * 9 + band
+                    std::uint32_t options = (plane[0] >> c & col_bits) | (plane[1] >> c & col_bits) << 1 | (plane[2] >> c & col_bits) << 2;
+                    if (!options) return false;
+                    if (single_bit(options))
+                    {
+                        int k = __builtin_ctz(options);
+                        place<Ops>(p, d, k % 9, k / 9 * 9 + c);
+                        changed = true;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Naked then hidden singles to a fixpoint, false on a contradiction
+        template <typename Ops>
+        bool propagate(Planes& p)
+        {
+            while (p.unsolved[0] | p.unsolved[1] | p.unsolved[2])
+            {
+                std::uint32_t ones[4], twos[4], threes[4];
+                Ops::count(p.cand, ones, twos, threes);
+
+                bool changed = false;
+                for (int b = 0; b < 3; ++b)
+                {
+                    if (p.unsolved[b] & ~ones[b])
+                    {
+                        return false;
+                    }
+
+                    std::uint32_t singles = p.unsolved[b] & ~twos[b];
+                    while (singles)
+                    {
+                        int i = __builtin_ctz(singles);
+                        singles &= singles - 1;
+
+                        // An earlier single of this pass may have taken the last candidate
+                        int d = 0;
+                        while (d < 9 && !(p.cand[d * 4 + b] & 1u << i)) ++d;
+                        if (d == 9)
+                        {
+                            return false;
+                        }
+                        place<Ops>(p, d, b, i);
+                        changed = true;
+                    }
+                }
+                if (changed) continue; // Cheap rule first, hidden singles only when it stalls
+
+                if (!hidden_singles<Ops>(p, changed))
+                {
+                    return false;
+                }
+                if (!changed) break;
+            }
+            return true;
+        }
+
+        // Empty cells left in p
+        inline int unsolved_cells(const Planes& p)
+        {
+            return __builtin_popcount(p.unsolved[0]) + __builtin_popcount(p.unsolved[1]) + __builtin_popcount(p.unsolved[2]);
+        }
+
+        // Empty cell to branch on, a two-candidate one when there is one;
+        // false when the board is full
+        template <typename Ops>
+        bool choose_cell(const Planes& p, int& band, int& i)
+        {
+            std::uint32_t ones[4], twos[4], threes[4];
+            Ops::count(p.cand, ones, twos, threes);
+
+            for (int b = 0; b < 3; ++b)
+            {
+                std::uint32_t pairs = p.unsolved[b] & twos[b] & ~threes[b];
+                if (pairs)
+                {
+                    band = b;
+                    i = __builtin_ctz(pairs);
+                    return true;
+                }
+            }
+            for (int b = 0; b < 3; ++b)
+            {
+                if (p.unsolved[b])
+                {
+                    band = b;
+                    i = __builtin_ctz(p.unsolved[b]);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Depth first search over copies of the planes: a child takes the lowest
+        // candidate of the chosen cell, its parent drops it and is propagated
+        // again when the child fails. Every level places at least one digit, so
+        // 82 states bound the stack.
+        template <typename Ops>
+        Result solve_planes(Board& board, long long* nodes, SearchStats* stats)
+        {
+            Planes stack[82];
+            Planes& root = stack[0];
+            for (int d = 0; d < 9; ++d)
+            {
+                for (int b = 0; b < 3; ++b)
+                {
+                    root.cand[d * 4 + b] = band_full;
+                    root.placed[d * 4 + b] = 0;
+                }
+                root.cand[d * 4 + 3] = 0;
+                root.placed[d * 4 + 3] = 0;
+            }
+            for (int i = 36; i < 40; ++i) root.cand[i] = 0;
+            for (int b = 0; b < 3; ++b) root.unsolved[b] = band_full;
+            root.unsolved[3] = 0;
+            for (int i = 0; i < 81; ++i) root.value[i] = 0;
+
+            const std::uint8_t* cells = board.data();
+            for (int cell = 0; cell < 81; ++cell)
+            {
+                int num = cells[cell];
+                if (num == 0) continue;
+
+                int r = cell / 9;
+                int i = r % 3 * 9 + cell % 9;
+                if (num > 9 || !(root.cand[(num - 1) * 4 + r / 3] & 1u << i))
+                {
+                    return Result::Invalid;
+                }
+                place<Ops>(root, num - 1, r / 3, i);
+            }
+
+            long long branches = 0;
+            int depth = 0;
+            while (depth >= 0)
+            {
+                Planes& p = stack[depth];
+#if SEARCH_STATS
+                int open = stats ? unsolved_cells(p) : 0;
+                bool consistent = propagate<Ops>(p);
+                if (stats)
+                {
+                    stats->forced += open - unsolved_cells(p);
+                    if (!consistent) ++stats->backtracks;
+                }
+                if (!consistent)
+#else
+                if (!propagate<Ops>(p))
+#endif
+                {
+                    --depth;
+                    continue;
+                }
+
+                int band, i;
+                if (!choose_cell<Ops>(p, band, i))
+                {
+                    std::uint8_t* out = board.data();
+                    for (int cell = 0; cell < 81; ++cell) out[cell] = p.value[cell];
+                    if (nodes) *nodes = branches;
+                    return Result::Solved;
+                }
+
+                int d = 0;
+                while (!(p.cand[d * 4 + band] & 1u << i)) ++d;
+
+                stack[depth + 1] = p;
+                p.cand[d * 4 + band] &= ~(1u << i);
+                place<Ops>(stack[depth + 1], d, band, i);
+#if SEARCH_STATS
+                if (stats) stats->branch(depth);
+#endif
+                ++depth;
+                ++branches;
+            }
+
+            if (nodes) *nodes = branches;
+            return Result::Unsolvable;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#include "constraint_tracker.hpp"
+
+namespace solver
+{
+    void ConstraintTracker::reset(const Board& board, int subgrid_size)
+    {
+        size = board.size();
+        cells = size * size;
+        filled = 0;
+        repeats = 0;
+        this->subgrid_size = subgrid_size;
+        row_counts.assign(size * (size + 1), 0);
+        col_counts.assign(size * (size + 1), 0);
+        box_counts.assign(size * (size + 1), 0);
+        for (int row = 0; row < size; ++row)
+        {
+            for (int col = 0; col < size; ++col)
+            {
+                set(row, col, 0, board[row][col]);
+            }
+        }
+    }
+
+    void ConstraintTracker::set(int row, int col, int old_value, int new_value)
+    {
+        if (old_value == new_value)
+        {
+            return;
+        }
+        int box = box_of(row, col);
+        if (old_value)
+        {
+            remove(row_counts, row, old_value);
+            remove(col_counts, col, old_value);
+            remove(box_counts, box, old_value);
+            --filled;
+        }
+        if (new_value)
+        {
+            add(row_counts, row, new_value);
+            add(col_counts, col, new_value);
+            add(box_counts, box, new_value);
+            ++filled;
+        }
+    }
+
+    bool ConstraintTracker::conflicts(int row, int col, int value) const
+    {
+        if (!value)
+        {
+            return false;
+        }
+        int stride = size + 1;
+        return row_counts[row * stride + value] > 1 || col_counts[col * stride + value] > 1 ||
+               box_counts[box_of(row, col) * stride + value] > 1;
+    }
+
+    void ConstraintTracker::add(std::vector<uint16_t>& counts, int unit, int value)
+    {
+        if (counts[unit * (size + 1) + value]++) ++repeats;
+    }
+
+    void ConstraintTracker::remove(std::vector<uint16_t>& counts, int unit, int value)
+    {
+        if (--counts[unit * (size + 1) + value]) --repeats;
+    }
+}
@@ -0,0 +1,298 @@
+#include "dlx.hpp"
+#include "search_watch.hpp"
+
+namespace solver
+{
+    DancingLinks::DancingLinks(int size, int subgrid_size):
+        size(size),
+        subgrid_size(subgrid_size)
+    {
+    }
+
+    // Search times are heavy tailed: one bad early choice can hide a solution
+    // behind a huge dead subtree. Restart with a doubled row budget and random
+    // MRV tie-breaking, so the total work stays within a small factor of the
+    // luckiest run while the growing budget keeps the search complete.
+    bool DancingLinks::solve(Board& board)
+    {
+        nodes = 0;
+        tie_break = 0;
+        long long limit = 16 * (long long)size * size;
+
+        while (true)
+        {
+            SearchResult result = search(limit);
+            if (result == SearchResult::Found)
+            {
+                break;
+            }
+            if (result == SearchResult::Exhausted || result == SearchResult::Cancelled)
+            {
+                return false;
+            }
+            unwind();
+            limit *= 2;
+            tie_break = tie_break * 1664525u + 1013904223u + (std::uint32_t)nodes;
+        }
+
+        store(board);
+        return true;
+    }
+
+    void DancingLinks::store(Board& board) const
+    {
+        board = loaded;
+        for (int node : choice)
+        {
+            int cell = row_of[node] / size;
+            board[cell / size][cell % size] = row_of[node] % size + 1;
+        }
+    }
+
+    bool DancingLinks::load(const Board& board)
+    {
+        int n = size;
+        int cells = n * n;
+        int columns = 4 * cells;
+        loaded = board;
+
+        std::vector<char> seen_row(cells, 0), seen_col(cells, 0), seen_subgrid(cells, 0);
+        givens = 0;
+        for (int row = 0; row < n; ++row)
+        {
+            for (int col = 0; col < n; ++col)
+            {
+                int num = board[row][col];
+                if (num == 0) continue;
+
+                int index = num - 1;
+                int subgrid = (row / subgrid_size) * subgrid_size + col / subgrid_size;
+                if (seen_row[row * n + index] || seen_col[col * n + index] || seen_subgrid[subgrid * n + index])
+                {
+                    return false;
+                }
+                seen_row[row * n + index] = 1;
+                seen_col[col * n + index] = 1;
+                seen_subgrid[subgrid * n + index] = 1;
+                ++givens;
+            }
+        }
+
+        left.assign(columns + 1, 0);
+        right.assign(columns + 1, 0);
+        up.resize(columns + 1);
+        down.resize(columns + 1);
+        column.resize(columns + 1);
+        row_of.assign(columns + 1, -1);
+        column_size.assign(columns + 1, 0);
+        choice.clear();
+
+        // Only constraints that the givens leave open are linked into the header list
+        int last = 0;
+        for (int c = 1; c <= columns; ++c)
+        {
+            up[c] = down[c] = column[c] = c;
+
+            int id = c - 1;
+            int kind = id / cells;
+            int rest = id % cells;
+            bool satisfied = false;
+            if (kind == 0) satisfied = board[rest / n][rest % n] != 0;
+            else if (kind == 1) satisfied = seen_row[rest];
+            else if (kind == 2) satisfied = seen_col[rest];
+            else satisfied = seen_subgrid[rest];
+
+            if (satisfied) continue;
+
+            left[c] = last;
+            right[last] = c;
+            last = c;
+        }
+        right[last] = 0;
+        left[0] = last;
+        up[0] = down[0] = column[0] = 0;
+
+        for (int row = 0; row < n; ++row)
+        {
+            for (int col = 0; col < n; ++col)
+            {
+                if (board[row][col] != 0) continue;
+
+                int subgrid = (row / subgrid_size) * subgrid_size + col / subgrid_size;
+                for (int index = 0; index < n; ++index)
+                {
+                    if (seen_row[row * n + index] || seen_col[col * n + index] || seen_subgrid[subgrid * n + index])
+                    {
+                        continue;
+                    }
+                    int row_columns[4] =
+                    {
+                        1 + row * n + col,
+                        1 + cells + row * n + index,
+                        1 + 2 * cells + col * n + index,
+                        1 + 3 * cells + subgrid * n + index
+                    };
+                    add_row((row * n + col) * n + index, row_columns);
+                }
+            }
+        }
+        return true;
+    }
+
+    void DancingLinks::add_row(int row_id, const int columns[4])
+    {
+        int first = (int)left.size();
+        for (int i = 0; i < 4; ++i)
+        {
+            int node = first + i;
+            int c = columns[i];
+
+            left.push_back(i == 0 ? first + 3 : node - 1);
+            right.push_back(i == 3 ? first : node + 1);
+            up.push_back(up[c]);
+            down.push_back(c);
+            column.push_back(c);
+            row_of.push_back(row_id);
+
+            down[up[c]] = node;
+            up[c] = node;
+            ++column_size[c];
+        }
+    }
+
+    int DancingLinks::choose_column()
+    {
+        int best = right[0];
+        int ties = 1;
+        for (int c = right[best]; c != 0 && column_size[best] > 1; c = right[c])
+        {
+            if (column_size[c] < column_size[best])
+            {
+                best = c;
+                ties = 1;
+            }
+            else if (tie_break && column_size[c] == column_size[best])
+            {
+                // Reservoir sampling keeps every tied column equally likely
+                tie_break ^= tie_break << 13;
+                tie_break ^= tie_break >> 17;
+                tie_break ^= tie_break << 5;
+                if (tie_break % ++ties == 0)
+                {
+                    best = c;
+                }
+            }
+        }
+        return best;
+    }
+
+    void DancingLinks::cover(int c)
+    {
+#if SEARCH_STATS
+        if (stats) stats->rows_covered += column_size[c]; // Its rows leave every other column
+#endif
+        right[left[c]] = right[c];
+        left[right[c]] = left[c];
+        for (int i = down[c]; i != c; i = down[i])
+        {
+            for (int j = right[i]; j != i; j = right[j])
+            {
+                down[up[j]] = down[j];
+                up[down[j]] = up[j];
+                --column_size[column[j]];
+            }
+        }
+    }
+
+    void DancingLinks::uncover(int c)
+    {
+        for (int i = up[c]; i != c; i = up[i])
+        {
+            for (int j = left[i]; j != i; j = left[j])
+            {
+                ++column_size[column[j]];
+                down[up[j]] = j;
+                up[down[j]] = j;
+            }
+        }
+        right[left[c]] = c;
+        left[right[c]] = c;
+    }
+
+    // Iterative Algorithm X, choice holds the row node picked at every level
+    // so the depth is bounded by the number of empty cells and not the call stack.
+    DancingLinks::SearchResult DancingLinks::search(long long limit)
+    {
+        long long start = nodes;
+        while (true)
+        {
+            if (right[0] == 0)
+            {
+                return SearchResult::Found;
+            }
+            if (nodes - start >= limit)
+            {
+                return SearchResult::Limit;
+            }
+
+            int c = choose_column();
+            cover(c);
+            int r = down[c];
+
+            // Find the next row to try at this level, backtracking through finished levels
+            while (r == c)
+            {
+#if SEARCH_STATS
+                if (stats) ++stats->backtracks; // An empty column first, then every level out of rows
+#endif
+                uncover(c);
+                if (choice.empty())
+                {
+                    return SearchResult::Exhausted;
+                }
+                r = choice.back();
+                choice.pop_back();
+                c = column[r];
+                for (int j = left[r]; j != r; j = left[j])
+                {
+                    uncover(column[j]);
+                }
+                r = down[r];
+            }
+
+            ++nodes;
+            choice.push_back(r);
+#if SEARCH_STATS
+            if (stats) stats->branch((int)choice.size() - 1);
+#endif
+            if (progress && (nodes & 4095) == 0)
+            {
+                progress->nodes.store(nodes, std::memory_order_relaxed);
+                progress->cells.store(givens + (int)choice.size(), std::memory_order_relaxed);
+                parallel::watch_search(progress, *this, nodes);
+                if (progress->cancelled())
+                {
+                    return SearchResult::Cancelled; // solve returns without unwinding, the matrix is reloaded anyway
+                }
+            }
+            for (int j = right[r]; j != r; j = right[j])
+            {
+                cover(column[j]);
+            }
+        }
+    }
+
+    void DancingLinks::unwind()
+    {
+        while (!choice.empty())
+        {
+            int r = choice.back();
+            choice.pop_back();
+            for (int j = left[r]; j != r; j = left[j])
+            {
+                uncover(column[j]);
+            }
+            uncover(column[r]);
+        }
+    }
+}
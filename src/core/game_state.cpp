@@ -0,0 +1,163 @@
+#include "game_state.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace solver
+{
+    GameState::GameState(int board_size):
+        board(board_size),
+        from_puzzle(board_size)
+    {
+        if(!is_valid_board_size(board_size))
+        {
+            throw std::invalid_argument("Invalid board_size");
+        }
+        subgrid_size = subgrid_size_of(board_size);
+        initialize_subgrid_lut(board_size);
+        tracker.reset(board, subgrid_size);
+    }
+
+    bool GameState::is_valid_board_size(int size)
+    {
+        return subgrid_size_of(size) != 0;
+    }
+
+    void GameState::initialize_subgrid_lut(int size)
+    {
+        fill_subgrid_lut(subgrid_lut, size, subgrid_size);
+    }
+
+    void GameState::set_puzzle(const Board& puzzle, const Board& solution)
+    {
+        board = puzzle;
+        known_solution = solution;
+        is_solution_known = true;
+        set_from_puzzle_as_state();
+        tracker.reset(board, subgrid_size);
+    }
+
+    bool GameState::resize(int size)
+    {
+        subgrid_size = subgrid_size_of(size);
+        initialize_subgrid_lut(size);
+
+        Board new_board(size);
+        FlagBoard new_from_puzzle(size);
+
+        copy_board(board, new_board);
+        copy_board(from_puzzle, new_from_puzzle);
+
+        bool was_erased = false;
+        for(int row = 0; row < size; ++row)
+        {
+            for(int col = 0; col < size; ++col)
+            {
+                if(new_board[row][col] > size)
+                {
+                    new_board[row][col] = 0;
+                    new_from_puzzle[row][col] = false;
+                    was_erased = true;
+                }
+            }
+        }
+        board = std::move(new_board);
+        from_puzzle = std::move(new_from_puzzle);
+        tracker.reset(board, subgrid_size);
+        return !was_erased;
+    }
+
+    void GameState::clear_board()
+    {
+        board.fill(0);
+        clear_from_puzzle();
+        is_solution_known = false;
+        tracker.reset(board, subgrid_size);
+    }
+
+    void GameState::reset_board()
+    {
+        int n = board.size();
+        for(int row = 0; row < n; ++row)
+        {
+            for(int col = 0; col < n; ++col)
+            {
+                if(!from_puzzle[row][col]) set_cell(row, col, 0);
+            }
+        }
+    }
+
+    bool GameState::fill_known_solution()
+    {
+        if(!is_solution_known) return false;
+        copy_board(known_solution, board);
+        tracker.reset(board, subgrid_size);
+        return true;
+    }
+
+    void GameState::clear_from_puzzle()
+    {
+        from_puzzle.fill(false);
+    }
+
+    bool GameState::in_range(int v) const
+    {
+        return v >= 0 && v < (int)board.size();
+    }
+
+    void GameState::fit_known_solution_vec()
+    {
+        known_solution.assign(board.size());
+    }
+
+    void GameState::set_from_puzzle_as_state()
+    {
+        int n = board.size();
+        for(int row = 0; row < n; ++row)
+        {
+            for(int col = 0; col < n; ++col)
+            {
+                from_puzzle[row][col] = board[row][col] != 0;
+            }
+        }
+    }
+
+    // The puzzle's values become givens and the whole board is replaced in
+    // one step, so a solve that ran on another thread never shows half done
+    bool GameState::commit_solution(const Board& puzzle, const Board& solved)
+    {
+        int n = (int)board.size();
+        if((int)puzzle.size() != n || (int)solved.size() != n || !std::equal(board.data(), board.data() + n * n, puzzle.data()))
+        {
+            return false;
+        }
+
+        for(int cell = 0; cell < n * n; ++cell)
+        {
+            if(puzzle.data()[cell] != 0) from_puzzle.data()[cell] = true;
+        }
+        board = solved;
+        tracker.reset(board, subgrid_size);
+        return true;
+    }
+
+    Result GameState::solve(parallel::WorkStealingPool* pool, SearchStats* stats)
+    {
+        int n = (int)board.size();
+        Board puzzle = board;
+        Result result = solver::solve(board, subgrid_size, subgrid_lut, pool, nullptr, stats);
+        tracker.reset(board, subgrid_size);
+        if(result == Result::Invalid)
+        {
+            return result;
+        }
+
+        for(int row = 0; row < n; ++row)
+        {
+            for(int col = 0; col < n; ++col)
+            {
+                if(puzzle[row][col] != 0) from_puzzle[row][col] = true;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,264 @@
+#include "puzzle_bank.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace generator
+{
+    namespace
+    {
+        const char magic[8] = { 'S', 'D', 'K', 'B', 'A', 'N', 'K', '1' };
+        constexpr std::size_t header_bytes = 16;
+
+        void pack_cells(const solver::Board& board, int bits, uint8_t* out, uint64_t& bit)
+        {
+            const auto* cells = board.data();
+            std::size_t total = board.size() * board.size();
+            for (std::size_t i = 0; i < total; ++i)
+            {
+                for (int b = 0; b < bits; ++b, ++bit)
+                {
+                    if (cells[i] >> b & 1)
+                    {
+                        out[bit >> 3] |= uint8_t(1u << (bit & 7));
+                    }
+                }
+            }
+        }
+
+        // False when a cell decodes past size, which only a corrupt record holds
+        bool unpack_cells(const uint8_t* in, int size, int bits, uint64_t& bit, solver::Board& board)
+        {
+            board.assign(size);
+            auto* cells = board.data();
+            unsigned mask = (1u << bits) - 1;
+            std::size_t total = (std::size_t)size * size;
+            for (std::size_t i = 0; i < total; ++i, bit += bits)
+            {
+                // A cell spans at most two bytes since bits <= 8
+                std::size_t byte = bit >> 3;
+                unsigned shift = bit & 7;
+                unsigned word = in[byte];
+                if (shift + bits > 8) word |= unsigned(in[byte + 1]) << 8;
+                cells[i] = word >> shift & mask;
+                if (cells[i] > size) return false;
+            }
+            return true;
+        }
+
+        // Whether solution fills every row, column and box with 1 to size once
+        // and keeps the givens of puzzle. Cells are already known to be in range.
+        bool is_solution_of(const solver::Board& puzzle, const solver::Board& solution)
+        {
+            int size = (int)solution.size();
+            int subgrid_size = solver::subgrid_size_of(size);
+            std::vector<uint8_t> seen(3 * (std::size_t)size * (size + 1), 0); // Rows, then columns, then boxes
+            const auto* given = puzzle.data();
+            const auto* cells = solution.data();
+            for (int cell = 0; cell < size * size; ++cell)
+            {
+                int num = cells[cell];
+                if (num == 0 || (given[cell] && given[cell] != num)) return false;
+                int row = cell / size;
+                int col = cell % size;
+                int box = row / subgrid_size * subgrid_size + col / subgrid_size;
+                if (seen[row * (size + 1) + num]++ || seen[(size + col) * (size + 1) + num]++ ||
+                    seen[(2 * size + box) * (size + 1) + num]++)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    void PuzzleBankWriter::add(int level, const Puzzle& puzzle)
+    {
+        int size = (int)puzzle.puzzle.size();
+        if (!solver::subgrid_size_of(size) || (int)puzzle.solution.size() != size)
+        {
+            throw std::invalid_argument("Invalid Sudoku size.");
+        }
+        if (level < 1 || level > 255)
+        {
+            throw std::invalid_argument("Invalid puzzle level.");
+        }
+
+        auto group = std::find_if(groups.begin(), groups.end(),
+                                  [&](const Group& g) { return g.size == size && g.level == level; });
+        if (group == groups.end())
+        {
+            groups.push_back({size, level});
+            group = groups.end() - 1;
+        }
+
+        std::size_t record = bank_record_bytes(size);
+        group->records.resize(group->records.size() + record, 0);
+        uint8_t* out = group->records.data() + group->records.size() - record;
+        uint64_t bit = 0;
+        int bits = bank_cell_bits(size);
+        pack_cells(puzzle.puzzle, bits, out, bit);
+        pack_cells(puzzle.solution, bits, out, bit);
+        ++group->count;
+    }
+
+    std::size_t PuzzleBankWriter::size() const
+    {
+        std::size_t total = 0;
+        for (const auto& group : groups) total += group.count;
+        return total;
+    }
+
+    bool PuzzleBankWriter::write(const std::string& path) const
+    {
+        std::vector<const Group*> order;
+        for (const auto& group : groups) order.push_back(&group);
+        std::sort(order.begin(), order.end(), [](const Group* a, const Group* b)
+        {
+            return a->size != b->size ? a->size < b->size : a->level < b->level;
+        });
+
+        uint32_t group_count = (uint32_t)order.size();
+        uint32_t reserved = 0;
+        std::vector<BankGroup> index;
+        uint64_t offset = header_bytes + group_count * sizeof(BankGroup);
+        for (const Group* group : order)
+        {
+            index.push_back({(uint16_t)group->size, (uint8_t)group->level,
+                             (uint8_t)bank_cell_bits(group->size), group->count, offset});
+            offset += group->records.size();
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(magic, sizeof(magic));
+        file.write(reinterpret_cast<const char*>(&group_count), sizeof(group_count));
+        file.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+        file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(BankGroup));
+        for (const Group* group : order)
+        {
+            file.write(reinterpret_cast<const char*>(group->records.data()), group->records.size());
+        }
+        return (bool)file.flush();
+    }
+
+    PuzzleBank::~PuzzleBank()
+    {
+        close();
+    }
+
+    bool PuzzleBank::open(const std::string& path)
+    {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat info;
+        void* map = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && (std::size_t)info.st_size >= header_bytes)
+        {
+            map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd); // The mapping keeps the file alive
+        if (map == MAP_FAILED)
+        {
+            return false;
+        }
+
+        data = static_cast<const uint8_t*>(map);
+        length = info.st_size;
+        std::memcpy(&group_count, data + sizeof(magic), sizeof(group_count));
+        groups = reinterpret_cast<const BankGroup*>(data + header_bytes);
+
+        // Check the layout a lookup relies on once; cell values are checked as records are decoded
+        bool valid = std::memcmp(data, magic, sizeof(magic)) == 0 &&
+                     group_count <= (length - header_bytes) / sizeof(BankGroup);
+        for (uint32_t i = 0; valid && i < group_count; ++i)
+        {
+            const BankGroup& group = groups[i];
+            valid = solver::subgrid_size_of(group.size) && group.bits == bank_cell_bits(group.size) &&
+                    group.offset <= length &&
+                    group.count <= (length - group.offset) / bank_record_bytes(group.size) &&
+                    (i == 0 || std::make_pair(groups[i - 1].size, groups[i - 1].level) < std::make_pair(group.size, group.level));
+        }
+        if (!valid)
+        {
+            close();
+        }
+        picks = std::random_device{}(); // A different sequence of picks every run
+        return valid;
+    }
+
+    void PuzzleBank::close()
+    {
+        if (data)
+        {
+            munmap(const_cast<uint8_t*>(data), length);
+        }
+        data = nullptr;
+        length = 0;
+        groups = nullptr;
+        group_count = 0;
+    }
+
+    const BankGroup* PuzzleBank::find(int size, int level) const
+    {
+        const BankGroup* end = groups + group_count;
+        const BankGroup* group = std::lower_bound(groups, end, std::make_pair(size, level),
+                                                  [](const BankGroup& g, const std::pair<int, int>& key)
+        {
+            return std::make_pair((int)g.size, (int)g.level) < key;
+        });
+        return group != end && group->size == size && group->level == level ? group : nullptr;
+    }
+
+    std::size_t PuzzleBank::count(int size, int level) const
+    {
+        const BankGroup* group = find(size, level);
+        return group ? group->count : 0;
+    }
+
+    bool PuzzleBank::get(int size, int level, std::size_t index, Puzzle& puzzle) const
+    {
+        const BankGroup* group = find(size, level);
+        if (!group || index >= group->count)
+        {
+            return false;
+        }
+
+        const uint8_t* record = data + group->offset + index * bank_record_bytes(size);
+        uint64_t bit = 0;
+        if (!unpack_cells(record, size, group->bits, bit, puzzle.puzzle) ||
+            !unpack_cells(record, size, group->bits, bit, puzzle.solution) ||
+            !is_solution_of(puzzle.puzzle, puzzle.solution))
+        {
+            return false;
+        }
+        puzzle.rating = solver::Rating(); // Not stored in the bank
+        return true;
+    }
+
+    bool PuzzleBank::take(int size, int level, Puzzle& puzzle)
+    {
+        std::size_t available = count(size, level);
+        if (!available)
+        {
+            return false;
+        }
+
+        // Splitmix64 of a shared counter: consecutive picks land far apart
+        uint64_t x = picks.fetch_add(0x9e3779b97f4a7c15ULL, std::memory_order_relaxed) + 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return get(size, level, x % available, puzzle);
+    }
+}
@@ -0,0 +1,97 @@
+#include "puzzle_io.hpp"
+#include <vector>
+
+namespace solver
+{
+    static bool is_separator(char c)
+    {
+        return c == ',' || c == ' ' || c == '\t' || c == '\r';
+    }
+
+    bool parse_puzzle(const std::string& line, Board& board)
+    {
+        std::vector<int> cells;
+        cells.reserve(line.size());
+
+        bool delimited = line.find_first_of(", \t") != std::string::npos;
+        if (!delimited)
+        {
+            for (char c : line)
+            {
+                if (c == '\r') continue;
+                if (c == '.' || c == '0') cells.push_back(0);
+                else if (c >= '1' && c <= '9') cells.push_back(c - '0');
+                else return false;
+            }
+        }
+        else
+        {
+            size_t i = 0;
+            while (i < line.size())
+            {
+                if (is_separator(line[i]))
+                {
+                    ++i;
+                    continue;
+                }
+
+                int num = 0;
+                if (line[i] == '.')
+                {
+                    ++i;
+                }
+                else
+                {
+                    size_t start = i;
+                    while (i < line.size() && line[i] >= '0' && line[i] <= '9')
+                    {
+                        num = num * 10 + (line[i] - '0');
+                        if (num > MAX_BOARD_SIZE) return false;
+                        ++i;
+                    }
+                    if (i == start) return false;
+                }
+                cells.push_back(num);
+            }
+        }
+
+        int n = 1;
+        while (n * n < (int)cells.size()) ++n;
+        if (n * n != (int)cells.size() || subgrid_size_of(n) == 0)
+        {
+            return false;
+        }
+
+        board.assign(n);
+        for (int cell = 0; cell < n * n; ++cell)
+        {
+            if (cells[cell] > n) return false;
+            board.data()[cell] = cells[cell];
+        }
+        return true;
+    }
+
+    std::string format_puzzle(const Board& board)
+    {
+        int n = (int)board.size();
+        std::string out;
+        if (n <= 9)
+        {
+            out.reserve(n * n);
+            for (int cell = 0; cell < n * n; ++cell)
+            {
+                int num = board.data()[cell];
+                out.push_back(num == 0 ? '.' : char('0' + num));
+            }
+            return out;
+        }
+
+        out.reserve(n * n * 3);
+        for (int cell = 0; cell < n * n; ++cell)
+        {
+            if (cell) out.push_back(',');
+            out += std::to_string(board.data()[cell]);
+        }
+        return out;
+    }
+}
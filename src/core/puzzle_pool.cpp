@@ -0,0 +1,129 @@
+#include "puzzle_pool.hpp"
+#include <algorithm>
+#include "generator.hpp"
+
+namespace generator
+{
+    PuzzlePool::PuzzlePool(int threads, int capacity):
+        capacity(capacity),
+        queues((MAX_BOARD_SIZE + 1) * levels),
+        generating((MAX_BOARD_SIZE + 1) * levels, 0)
+    {
+        if (threads <= 0)
+        {
+            threads = std::max(1, (int)std::thread::hardware_concurrency() / 2);
+        }
+        for (int i = 0; i < threads; ++i)
+        {
+            this->threads.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    PuzzlePool::~PuzzlePool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void PuzzlePool::warm(int size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = std::find(warmed.begin(), warmed.end(), size);
+            if (it != warmed.end())
+            {
+                warmed.erase(it); // Moves to the back, it is the size in use now
+            }
+            warmed.push_back(size);
+        }
+        wake.notify_all();
+    }
+
+    bool PuzzlePool::try_take(int size, int level, Puzzle& out)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& queue = queues[size * levels + level - 1];
+            if (queue.empty())
+            {
+                return false;
+            }
+            out = std::move(queue.front());
+            queue.pop_front();
+        }
+        wake.notify_one(); // A worker refills the queue
+        return true;
+    }
+
+    int PuzzlePool::ready(int size, int level)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return (int)queues[size * levels + level - 1].size();
+    }
+
+    int PuzzlePool::pick_queue() const
+    {
+        int best = -1;
+        int best_fill = capacity;
+        for (auto size = warmed.rbegin(); size != warmed.rend(); ++size)
+        {
+            for (int level = 1; level <= levels; ++level)
+            {
+                int queue = *size * levels + level - 1;
+                int fill = (int)queues[queue].size() + generating[queue];
+                if (fill < best_fill)
+                {
+                    best = queue;
+                    best_fill = fill;
+                }
+            }
+        }
+        return best;
+    }
+
+    void PuzzlePool::worker_loop()
+    {
+        // One generator per size, reused for every puzzle this thread makes
+        std::vector<std::unique_ptr<SudokuGenerator>> generators(MAX_BOARD_SIZE + 1);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            int queue = -1;
+            wake.wait(lock, [&] { return stopping || (queue = pick_queue()) != -1; });
+            if (stopping)
+            {
+                return;
+            }
+
+            ++generating[queue];
+            lock.unlock();
+
+            int size = queue / levels;
+            int level = queue % levels + 1;
+            auto& generator = generators[size];
+            if (!generator)
+            {
+                generator = std::make_unique<SudokuGenerator>(size);
+                generator->set_stop_flag(&stopping);
+            }
+            Puzzle puzzle;
+            puzzle.puzzle = generator->generate_rated(level, puzzle.solution, &puzzle.rating);
+
+            lock.lock();
+            --generating[queue];
+            if (stopping)
+            {
+                return;
+            }
+            queues[queue].push_back(std::move(puzzle));
+        }
+    }
+}
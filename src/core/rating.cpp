@@ -0,0 +1,545 @@
+#include "rating.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace solver
+{
+    const char* technique_name(Technique technique)
+    {
+        switch (technique)
+        {
+            case Technique::None: return "none";
+            case Technique::HiddenSingle: return "hidden single";
+            case Technique::NakedSingle: return "naked single";
+            case Technique::LockedCandidates: return "locked candidates";
+            case Technique::Pair: return "pair";
+            case Technique::Fish: return "fish";
+            case Technique::Chain: return "chain";
+            case Technique::Search: return "search";
+        }
+        return "unknown";
+    }
+
+    static int popcount(std::uint64_t m) { return __builtin_popcountll(m); }
+    static int ctz(std::uint64_t m) { return __builtin_ctzll(m); }
+
+    Rater::Rater(int size):
+        size(size),
+        subgrid_size(subgrid_size_of(size)),
+        full(size >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << size) - 1),
+        cand(size * size),
+        value(size * size),
+        units(3 * size * size),
+        cell_units(3 * size * size),
+        color(size * size),
+        queue(size * size),
+        counter(make_solution_counter(size)),
+        stalled(size)
+    {
+        if (size > MAX_RATING_SIZE || !subgrid_size)
+        {
+            throw std::invalid_argument("Unsupported size for rating.");
+        }
+
+        int box = subgrid_size;
+        for (int u = 0; u < size; ++u)
+        {
+            int top = (u / box) * box;
+            int left = (u % box) * box;
+            for (int i = 0; i < size; ++i)
+            {
+                units[u * size + i] = u * size + i;
+                units[(size + u) * size + i] = i * size + u;
+                units[(2 * size + u) * size + i] = (top + i / box) * size + left + i % box;
+            }
+        }
+        for (int cell = 0; cell < size * size; ++cell)
+        {
+            int row = cell / size;
+            int col = cell % size;
+            cell_units[cell * 3] = row;
+            cell_units[cell * 3 + 1] = size + col;
+            cell_units[cell * 3 + 2] = 2 * size + (row / box) * box + col / box;
+        }
+    }
+
+    Rating Rater::rate(const Board& puzzle, Technique limit, long long max_nodes)
+    {
+        Rating rating;
+        std::fill(cand.begin(), cand.end(), full);
+        std::fill(value.begin(), value.end(), 0);
+        empty = size * size;
+
+        const std::uint8_t* cells = puzzle.data();
+        for (int cell = 0; cell < size * size; ++cell)
+        {
+            int num = cells[cell];
+            if (num != 0 && (num > size || !place(cell, num - 1)))
+            {
+                return rating; // Conflicting givens, no solution
+            }
+        }
+
+        while (empty > 0)
+        {
+            int progress = 0;
+            int technique = (int)Technique::HiddenSingle;
+            for (; technique <= (int)Technique::Chain; ++technique)
+            {
+                if (technique > (int)limit)
+                {
+                    rating.hardest = std::max(rating.hardest, (Technique)technique);
+                    rating.solutions = -1;
+                    return rating;
+                }
+
+                switch ((Technique)technique)
+                {
+                    case Technique::HiddenSingle: progress = hidden_singles(); break;
+                    case Technique::NakedSingle: progress = naked_singles(); break;
+                    case Technique::LockedCandidates: progress = locked_candidates(); break;
+                    case Technique::Pair: progress = pairs(); break;
+                    case Technique::Fish: progress = fish(); break;
+                    default: progress = chains(); break;
+                }
+                if (progress != 0) break;
+            }
+
+            if (progress < 0)
+            {
+                return rating; // Contradiction, no solution
+            }
+            if (progress == 0)
+            {
+                break; // Every technique stalled
+            }
+            rating.hardest = std::max(rating.hardest, (Technique)technique);
+            rating.steps += progress;
+        }
+
+        if (empty == 0)
+        {
+            rating.solutions = 1;
+            return rating;
+        }
+
+        rating.hardest = Technique::Search;
+        if (limit < Technique::Search)
+        {
+            rating.solutions = -1;
+            return rating;
+        }
+
+        std::copy(value.begin(), value.end(), stalled.data());
+        counter->load(stalled);
+        rating.solutions = counter->count(2, max_nodes);
+        rating.nodes = counter->get_nodes();
+        return rating;
+    }
+
+    bool Rater::place(int cell, int index)
+    {
+        std::uint64_t bit = std::uint64_t(1) << index;
+        if (!(cand[cell] & bit))
+        {
+            return false;
+        }
+
+        value[cell] = index + 1;
+        cand[cell] = 0;
+        --empty;
+        for (int k = 0; k < 3; ++k)
+        {
+            const int* cells = &units[cell_units[cell * 3 + k] * size];
+            for (int i = 0; i < size; ++i)
+            {
+                cand[cells[i]] &= ~bit;
+            }
+        }
+        return true;
+    }
+
+    int Rater::eliminate(int cell, std::uint64_t mask)
+    {
+        if (!(cand[cell] & mask))
+        {
+            return 0;
+        }
+        cand[cell] &= ~mask;
+        return 1;
+    }
+
+    bool Rater::sees(int a, int b) const
+    {
+        return cell_units[a * 3] == cell_units[b * 3] ||
+               cell_units[a * 3 + 1] == cell_units[b * 3 + 1] ||
+               cell_units[a * 3 + 2] == cell_units[b * 3 + 2];
+    }
+
+    // A digit with one place left in a unit goes there
+    int Rater::hidden_singles()
+    {
+        int found = 0;
+        for (int u = 0; u < 3 * size; ++u)
+        {
+            const int* cells = &units[u * size];
+            std::uint64_t once = 0, twice = 0, placed = 0;
+            for (int i = 0; i < size; ++i)
+            {
+                int cell = cells[i];
+                if (value[cell])
+                {
+                    placed |= std::uint64_t(1) << (value[cell] - 1);
+                }
+                else
+                {
+                    twice |= once & cand[cell];
+                    once |= cand[cell];
+                }
+            }
+            if ((once | placed) != full)
+            {
+                return -1;
+            }
+
+            std::uint64_t hidden = once & ~twice;
+            while (hidden)
+            {
+                int index = ctz(hidden);
+                hidden &= hidden - 1;
+
+                // An earlier single of this unit may have filled the cell
+                int i = 0;
+                while (i < size && !(cand[cells[i]] >> index & 1)) ++i;
+                if (i == size)
+                {
+                    return -1;
+                }
+                place(cells[i], index);
+                ++found;
+            }
+        }
+        return found;
+    }
+
+    // A cell with one candidate left takes it
+    int Rater::naked_singles()
+    {
+        int found = 0;
+        for (int cell = 0; cell < size * size; ++cell)
+        {
+            if (value[cell]) continue;
+
+            std::uint64_t options = cand[cell];
+            if (!options)
+            {
+                return -1;
+            }
+            if (!(options & (options - 1)))
+            {
+                place(cell, ctz(options));
+                ++found;
+            }
+        }
+        return found;
+    }
+
+    // Pointing: a digit of a subgrid confined to one of its rows (columns) leaves
+    // the rest of that row (column). Claiming: a digit of a row (column) confined
+    // to one subgrid leaves the rest of that subgrid.
+    int Rater::locked_candidates()
+    {
+        int box = subgrid_size;
+        int changed = 0;
+        std::uint64_t lines[8]; // Candidates of each row or column segment, box <= 8
+
+        for (int b = 0; b < size; ++b)
+        {
+            int top = (b / box) * box;
+            int left = (b % box) * box;
+            for (int by_col = 0; by_col < 2; ++by_col)
+            {
+                std::uint64_t once = 0, twice = 0;
+                for (int k = 0; k < box; ++k)
+                {
+                    std::uint64_t line = 0;
+                    for (int j = 0; j < box; ++j)
+                    {
+                        line |= by_col ? cand[(top + j) * size + left + k] : cand[(top + k) * size + left + j];
+                    }
+                    lines[k] = line;
+                    twice |= once & line;
+                    once |= line;
+                }
+
+                std::uint64_t confined = once & ~twice;
+                while (confined)
+                {
+                    std::uint64_t bit = confined & (~confined + 1);
+                    confined &= confined - 1;
+
+                    int k = 0;
+                    while (!(lines[k] & bit)) ++k;
+                    for (int i = 0; i < size; ++i)
+                    {
+                        if (by_col)
+                        {
+                            if (i < top || i >= top + box) changed += eliminate(i * size + left + k, bit);
+                        }
+                        else
+                        {
+                            if (i < left || i >= left + box) changed += eliminate((top + k) * size + i, bit);
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int line = 0; line < size; ++line)
+        {
+            for (int by_col = 0; by_col < 2; ++by_col)
+            {
+                std::uint64_t once = 0, twice = 0;
+                for (int s = 0; s < box; ++s)
+                {
+                    std::uint64_t segment = 0;
+                    for (int j = 0; j < box; ++j)
+                    {
+                        segment |= by_col ? cand[(s * box + j) * size + line] : cand[line * size + s * box + j];
+                    }
+                    lines[s] = segment;
+                    twice |= once & segment;
+                    once |= segment;
+                }
+
+                std::uint64_t confined = once & ~twice;
+                while (confined)
+                {
+                    std::uint64_t bit = confined & (~confined + 1);
+                    confined &= confined - 1;
+
+                    int s = 0;
+                    while (!(lines[s] & bit)) ++s;
+                    int b = by_col ? s * box + line / box : (line / box) * box + s;
+                    const int* cells = &units[(2 * size + b) * size];
+                    for (int i = 0; i < size; ++i)
+                    {
+                        int cell = cells[i];
+                        if ((by_col ? cell % size : cell / size) != line) changed += eliminate(cell, bit);
+                    }
+                }
+            }
+        }
+        return changed;
+    }
+
+    // Naked pair: two cells of a unit with the same two candidates own them.
+    // Hidden pair: two digits with the same two places in a unit fill them.
+    int Rater::pairs()
+    {
+        int changed = 0;
+        std::uint64_t places[MAX_RATING_SIZE];
+        for (int u = 0; u < 3 * size; ++u)
+        {
+            const int* cells = &units[u * size];
+            for (int i = 0; i < size; ++i)
+            {
+                std::uint64_t pair = cand[cells[i]];
+                if (popcount(pair) != 2) continue;
+
+                for (int j = i + 1; j < size; ++j)
+                {
+                    if (cand[cells[j]] != pair) continue;
+
+                    for (int k = 0; k < size; ++k)
+                    {
+                        if (k != i && k != j) changed += eliminate(cells[k], pair);
+                    }
+                }
+            }
+
+            std::fill(places, places + size, 0);
+            for (int i = 0; i < size; ++i)
+            {
+                std::uint64_t options = cand[cells[i]];
+                while (options)
+                {
+                    places[ctz(options)] |= std::uint64_t(1) << i;
+                    options &= options - 1;
+                }
+            }
+            for (int d = 0; d < size; ++d)
+            {
+                if (popcount(places[d]) != 2) continue;
+
+                for (int e = d + 1; e < size; ++e)
+                {
+                    if (places[e] != places[d]) continue;
+
+                    std::uint64_t others = full & ~(std::uint64_t(1) << d | std::uint64_t(1) << e);
+                    for (std::uint64_t in = places[d]; in; in &= in - 1)
+                    {
+                        changed += eliminate(cells[ctz(in)], others);
+                    }
+                }
+            }
+        }
+        return changed;
+    }
+
+    int Rater::fish()
+    {
+        int changed = 0;
+        for (int index = 0; index < size; ++index)
+        {
+            changed += fish_lines(index, 0, size); // Rows as base, columns as cover
+            changed += fish_lines(index, size, 0);
+        }
+        return changed;
+    }
+
+    // When a digit's places in k base lines (k = 2 or 3) span only k cross lines,
+    // it leaves those cross lines everywhere outside the base lines
+    int Rater::fish_lines(int index, int first_unit, int cover_unit)
+    {
+        std::uint64_t bit = std::uint64_t(1) << index;
+        std::uint64_t places[MAX_RATING_SIZE];
+        int base[MAX_RATING_SIZE];
+        int count = 0;
+        for (int line = 0; line < size; ++line)
+        {
+            const int* cells = &units[(first_unit + line) * size];
+            std::uint64_t in = 0;
+            for (int i = 0; i < size; ++i)
+            {
+                if (cand[cells[i]] & bit) in |= std::uint64_t(1) << i;
+            }
+            int n = popcount(in);
+            if (n >= 2 && n <= 3)
+            {
+                places[count] = in;
+                base[count] = line;
+                ++count;
+            }
+        }
+
+        int changed = 0;
+        auto clear_cover = [&](std::uint64_t cover, int a, int b, int c)
+        {
+            for (; cover; cover &= cover - 1)
+            {
+                const int* cells = &units[(cover_unit + ctz(cover)) * size];
+                for (int j = 0; j < size; ++j)
+                {
+                    if (j != base[a] && j != base[b] && j != base[c]) changed += eliminate(cells[j], bit);
+                }
+            }
+        };
+
+        for (int a = 0; a < count; ++a)
+        {
+            for (int b = a + 1; b < count; ++b)
+            {
+                std::uint64_t two = places[a] | places[b];
+                if (popcount(two) == 2)
+                {
+                    clear_cover(two, a, b, b); // X-Wing
+                    continue;
+                }
+                if (popcount(two) > 3) continue;
+
+                for (int c = b + 1; c < count; ++c)
+                {
+                    std::uint64_t three = two | places[c];
+                    if (popcount(three) == 3) clear_cover(three, a, b, c); // Swordfish
+                }
+            }
+        }
+        return changed;
+    }
+
+    // Simple colouring: cells linked by conjugate pairs (the only two places of a
+    // digit in a unit) alternate between true and false. A colour appearing twice
+    // in one unit is false, and a cell seeing both colours cannot hold the digit.
+    int Rater::chains()
+    {
+        int changed = 0;
+        for (int index = 0; index < size && !changed; ++index)
+        {
+            std::uint64_t bit = std::uint64_t(1) << index;
+            std::fill(color.begin(), color.end(), -1);
+            int components = 0;
+
+            for (int start = 0; start < size * size && !changed; ++start)
+            {
+                if (!(cand[start] & bit) || color[start] != -1) continue;
+
+                // Breadth first over the conjugate links, colours 2c and 2c + 1
+                int base = 2 * components++;
+                int head = 0, tail = 0;
+                queue[tail++] = start;
+                color[start] = base;
+                while (head < tail)
+                {
+                    int cell = queue[head++];
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const int* cells = &units[cell_units[cell * 3 + k] * size];
+                        int places = 0, other = -1;
+                        for (int i = 0; i < size; ++i)
+                        {
+                            if (cand[cells[i]] & bit)
+                            {
+                                ++places;
+                                if (cells[i] != cell) other = cells[i];
+                            }
+                        }
+                        if (places == 2 && color[other] == -1)
+                        {
+                            color[other] = color[cell] ^ 1;
+                            queue[tail++] = other;
+                        }
+                    }
+                }
+                // Colour wrap
+                int wrong = -1;
+                for (int a = 0; a < tail && wrong == -1; ++a)
+                {
+                    for (int b = a + 1; b < tail; ++b)
+                    {
+                        if (color[queue[a]] == color[queue[b]] && sees(queue[a], queue[b]))
+                        {
+                            wrong = color[queue[a]];
+                            break;
+                        }
+                    }
+                }
+                if (wrong != -1)
+                {
+                    for (int i = 0; i < tail; ++i)
+                    {
+                        if (color[queue[i]] == wrong) changed += eliminate(queue[i], bit);
+                    }
+                    break;
+                }
+
+                // Colour trap
+                for (int cell = 0; cell < size * size; ++cell)
+                {
+                    if (!(cand[cell] & bit) || color[cell] == base || color[cell] == base + 1) continue;
+
+                    bool sees_even = false, sees_odd = false;
+                    for (int i = 0; i < tail && !(sees_even && sees_odd); ++i)
+                    {
+                        if (sees(cell, queue[i]))
+                        {
+                            (color[queue[i]] == base ? sees_even : sees_odd) = true;
+                        }
+                    }
+                    if (sees_even && sees_odd) changed += eliminate(cell, bit);
+                }
+            }
+        }
+        return changed;
+    }
+}
@@ -0,0 +1,41 @@
+#include "search_stats.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace solver
+{
+    void SearchStats::merge(const SearchStats& other)
+    {
+        nodes += other.nodes;
+        backtracks += other.backtracks;
+        forced += other.forced;
+        rows_covered += other.rows_covered;
+        max_depth = std::max(max_depth, other.max_depth);
+        if (branches.size() < other.branches.size()) branches.resize(other.branches.size(), 0);
+        for (std::size_t depth = 0; depth < other.branches.size(); ++depth)
+        {
+            branches[depth] += other.branches[depth];
+        }
+    }
+
+    void SearchStats::clear()
+    {
+        *this = SearchStats();
+    }
+
+    std::string SearchStats::to_json() const
+    {
+        char text[256];
+        std::snprintf(text, sizeof(text),
+                      "{\"nodes\": %lld, \"backtracks\": %lld, \"forced\": %lld, \"rows_covered\": %lld, \"max_depth\": %d, \"wall_ms\": %.3f, \"branches\": [",
+                      nodes, backtracks, forced, rows_covered, max_depth, wall_ms);
+        std::string json = text;
+        for (std::size_t depth = 0; depth < branches.size(); ++depth)
+        {
+            if (depth) json += ", ";
+            json += std::to_string(branches[depth]);
+        }
+        json += "]}";
+        return json;
+    }
+}
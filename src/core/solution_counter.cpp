@@ -0,0 +1,35 @@
+#include "solution_counter.hpp"
+#include "search.hpp"
+
+namespace solver
+{
+    namespace
+    {
+        template <typename Mask>
+        class SearchCounter : public SolutionCounter
+        {
+        public:
+            explicit SearchCounter(int size) : search(size, (fill_subgrid_lut(subgrid_lut, size, subgrid_size_of(size)), subgrid_lut)) {}
+
+            bool load(const Board& board) override { return search.load(board); }
+            void remove_given(int cell) override { search.remove_given(cell); }
+            bool add_given(int cell, int num) override { return search.add_given(cell, num); }
+            int count(int limit, long long max_nodes) override { return search.count_solutions(limit, max_nodes); }
+            long long get_nodes() const override { return search.get_nodes(); }
+
+        private:
+            SubgridLut subgrid_lut; // Declared first, the search keeps a pointer to it
+            Search<Mask> search;
+        };
+    }
+
+    std::unique_ptr<SolutionCounter> make_solution_counter(int size)
+    {
+        std::unique_ptr<SolutionCounter> counter;
+        bitmask::dispatch(size, [&](auto tag)
+        {
+            counter = std::make_unique<SearchCounter<typename decltype(tag)::type>>(size);
+        });
+        return counter;
+    }
+}
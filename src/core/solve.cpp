@@ -0,0 +1,108 @@
+#include "solve.hpp"
+#include "bitplane9.hpp"
+#include "dlx.hpp"
+#include "search.hpp"
+#include "parallel_search.hpp"
+#include "search_watch.hpp"
+#include "timing.hpp"
+
+namespace solver
+{
+    constexpr long long progress_budget = 4096; // Branches between progress reports and cancel checks
+    constexpr long long watch_budget = 1024; // The same while snapshots are wanted, so big boards still get several a second
+
+    template <typename Mask>
+    static Result solve_propagation(Board& board, const SubgridLut& subgrid_lut, parallel::WorkStealingPool* pool,
+                                    parallel::Progress* progress, SearchStats* stats)
+    {
+        int n = (int)board.size();
+        Search<Mask> search(n, subgrid_lut);
+        if (!search.load(board))
+        {
+            return Result::Invalid;
+        }
+
+        if (pool && n >= PARALLEL_SOLVE_SIZE && pool->size() > 1)
+        {
+            return parallel_solve(search, *pool, board, progress, stats) ? Result::Solved : Result::Unsolvable;
+        }
+        search.set_stats(stats);
+
+        if (!progress)
+        {
+            if (!search.solve())
+            {
+                return Result::Unsolvable;
+            }
+            search.store(board);
+            return Result::Solved;
+        }
+
+        using Status = typename Search<Mask>::Status;
+        Status status;
+        long long budget = progress->watch ? watch_budget : progress_budget;
+        while ((status = search.run(budget)) == Status::Running && !progress->cancelled())
+        {
+            progress->nodes.store(search.get_nodes(), std::memory_order_relaxed);
+            progress->cells.store(search.get_filled(), std::memory_order_relaxed);
+            parallel::watch_search(progress, search, search.get_nodes());
+        }
+        progress->nodes.store(search.get_nodes(), std::memory_order_relaxed);
+        if (status != Status::Solved)
+        {
+            return Result::Unsolvable;
+        }
+        search.store(board);
+        return Result::Solved;
+    }
+
+    static Result solve_any(Board& board, int subgrid_size, const SubgridLut& subgrid_lut, parallel::WorkStealingPool* pool,
+                            parallel::Progress* progress, SearchStats* stats)
+    {
+        int n = (int)board.size();
+        if (n == 9)
+        {
+            // Microseconds even on hard puzzles, not worth a cancel check
+            long long nodes = 0;
+            Result result = solve_bitplane9(board, &nodes, stats);
+            if (progress) progress->nodes.store(nodes, std::memory_order_relaxed);
+            return result;
+        }
+        if (n > MAX_PROPAGATION_SIZE)
+        {
+            DancingLinks dlx(n, subgrid_size);
+            dlx.set_progress(progress);
+            dlx.set_stats(stats);
+            if (!dlx.load(board))
+            {
+                return Result::Invalid;
+            }
+            return dlx.solve(board) ? Result::Solved : Result::Unsolvable;
+        }
+
+        // Picks the narrowest mask for n at compile time (uint32 up to 32, uint64 up to 64, ...)
+        Result result = Result::Unsolvable;
+        bitmask::dispatch(n, [&](auto tag)
+        {
+            result = solve_propagation<typename decltype(tag)::type>(board, subgrid_lut, pool, progress, stats);
+        });
+        return result;
+    }
+
+    Result solve(Board& board, int subgrid_size, const SubgridLut& subgrid_lut, parallel::WorkStealingPool* pool,
+                 parallel::Progress* progress, SearchStats* stats)
+    {
+#if SEARCH_STATS
+        timing::Stopwatch stopwatch;
+        Result result = solve_any(board, subgrid_size, subgrid_lut, pool, progress, stats);
+        if (stats) stats->wall_ms += stopwatch.elapsed_ms();
+#else
+        Result result = solve_any(board, subgrid_size, subgrid_lut, pool, progress, stats);
+#endif
+        if (result == Result::Unsolvable && progress && progress->cancelled())
+        {
+            return Result::Cancelled; // The engine gave up because of the flag, not the puzzle
+        }
+        return result;
+    }
+}
@@ -0,0 +1,136 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+
+namespace parallel
+{
+    thread_local const WorkStealingPool* WorkStealingPool::current_pool = nullptr;
+    thread_local int WorkStealingPool::current_index = -1;
+
+    WorkStealingPool::WorkStealingPool(int threads_count)
+    {
+        if (threads_count <= 0)
+        {
+            threads_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (int i = 0; i < threads_count; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        for (int i = 0; i < threads_count; ++i)
+        {
+            threads.emplace_back(&WorkStealingPool::worker_loop, this, i);
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void WorkStealingPool::submit(Task task)
+    {
+        int index = current_pool == this ? current_index : (int)(next_worker++ % workers.size());
+        {
+            std::lock_guard<std::mutex> lock(workers[index]->mutex);
+            workers[index]->tasks.push_back(std::move(task));
+        }
+        {
+            // Taking the lock orders the increment with a worker checking before it sleeps
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            ++queued;
+        }
+        wake.notify_one();
+    }
+
+    bool WorkStealingPool::hungry() const
+    {
+        return idle.load(std::memory_order_relaxed) > 0 && queued.load(std::memory_order_relaxed) == 0;
+    }
+
+    bool WorkStealingPool::pop(int index, Task& task)
+    {
+        {
+            Worker& own = *workers[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                --queued;
+                return true;
+            }
+        }
+
+        int count = (int)workers.size();
+        for (int i = 1; i < count; ++i)
+        {
+            Worker& victim = *workers[(index + i) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                --queued;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingPool::worker_loop(int index)
+    {
+        current_pool = this;
+        current_index = index;
+
+        while (true)
+        {
+            Task task;
+            if (pop(index, task))
+            {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            ++idle;
+            wake.wait(lock, [this] { return stopping || queued > 0; });
+            --idle;
+            if (stopping && queued == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    void TaskGroup::run(WorkStealingPool::Task task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++pending;
+        }
+        pool.submit([this, task = std::move(task)]
+        {
+            task();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0)
+            {
+                done.notify_all();
+            }
+        });
+    }
+
+    void TaskGroup::wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+    }
+}
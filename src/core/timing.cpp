@@ -0,0 +1,48 @@
+#include "timing.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace timing
+{
+    Histogram::Histogram(std::size_t capacity) :
+        samples(std::max<std::size_t>(capacity, 1))
+    {
+    }
+
+    void Histogram::add(double value)
+    {
+        samples[next] = value;
+        next = next + 1 == samples.size() ? 0 : next + 1;
+        filled = std::min(filled + 1, samples.size());
+        latest = value;
+    }
+
+    void Histogram::clear()
+    {
+        next = 0;
+        filled = 0;
+        latest = 0;
+    }
+
+    double Histogram::max() const
+    {
+        return filled ? *std::max_element(samples.begin(), samples.begin() + filled) : 0.0;
+    }
+
+    double percentile(std::vector<double> values, double p)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        std::size_t rank = (std::size_t)std::ceil(std::min(std::max(p, 0.0), 100.0) / 100.0 * values.size());
+        std::size_t index = rank ? rank - 1 : 0;
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    double Histogram::percentile(double p) const
+    {
+        return timing::percentile(std::vector<double>(samples.begin(), samples.begin() + filled), p); // The window is small
+    }
+}
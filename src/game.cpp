@@ -1,18 +1,14 @@
 #include "game.hpp"
-#include <algorithm>
+#include <memory>
 #include "generator.hpp"
+#include "timing.hpp"
 
 Game::Game(int board_size):
-    board(board_size, std::vector<int>(board_size, 0)),
-    from_puzzle(board_size, std::vector<bool>(board_size, false)),
+    solver::GameState(board_size),
     gui(this)
 {
-    if(!is_valid_board_size(board_size))
-    {
-        throw std::runtime_error("Invalid board_size");
-    }
-    subgrid_size = subgrid_size_map.at(board_size);
-    initialize_subgrid_lut(board_size);
+    bank.open(PUZZLE_BANK_PATH); // Stays closed, and empty, without a bank file
+    warm_puzzles();
 }
 
 void Game::run()
@@ -20,26 +16,10 @@ void Game::run()
     while(running)
     {
         gui.update();
+        finish_job();
     }
 }
 
-void Game::initialize_subgrid_lut(int size)
-{
-    if(size > MAX_BOARD_SIZE || size <= 0) std::cout << "Unsupported size " << size << "\n"; // Debuging
-    for (int r = 0; r < size; ++r)
-    {
-        for (int c = 0; c < size; ++c)
-        {
-            subgrid_lut[r][c] = (r / subgrid_size) * subgrid_size + c / subgrid_size;
-        }
-    }
-}
-
-bool Game::is_valid_board_size(int size)
-{
-    return subgrid_size_map.find(size) != subgrid_size_map.end();
-}
-
 void Game::change_board_size_if_valid(int size)
 {
     if (!is_valid_board_size(size) || size == (int)board.size()) 
@@ -47,208 +27,117 @@ void Game::change_board_size_if_valid(int size)
         return;
     }
 
-    subgrid_size = subgrid_size_map.at(size);
-    initialize_subgrid_lut(size);
-
-    Board new_board(size, std::vector<int>(size, 0));
-    BoolBoard new_from_puzzle(size, std::vector<bool>(size, false));
-
-    copy_board(board, new_board);
-    copy_board(from_puzzle, new_from_puzzle);
-
-    bool was_erased = false;
-    for(int row = 0; row < size; ++row)
-    {
-        for(int col = 0; col < size; ++col)
-        {
-            if(new_board[row][col] < 0 || new_board[row][col] > size) 
-            {
-                new_board[row][col] = 0;
-                new_from_puzzle[row][col] = false;
-                was_erased = true; 
-            }
-        }
-    }
-    if(was_erased) gui.pop_up_message("Some data was removed tho to being out of range", 2000, {0, 0, 144});
-    board = std::move(new_board);
-    from_puzzle = std::move(new_from_puzzle);
+    if(!resize(size)) gui.pop_up_message("Some data was removed tho to being out of range", 2000, {0, 0, 144});
     gui.update_by_board_size();
+    warm_puzzles();
 }
 
-
-void Game::clear_board()
+void Game::warm_puzzles()
 {
-    for (auto& row : board)
+    if((int)board.size() <= MAX_GENERATE_SIZE)
     {
-        std::fill(row.begin(), row.end(), 0);
+        puzzles.warm(board.size());
     }
-    clear_from_puzzle();
-    is_solution_known = false; 
 }
 
-void Game::clear_from_puzzle()
+void Game::solve_board()
 {
-    for (auto& row : from_puzzle)
+    if(task.running())
     {
-        std::fill(row.begin(), row.end(), false);
+        gui.pop_up_message("Busy, press Stop first");
+        return;
     }
-}
 
-bool Game::in_range(int v)
-{
-    return v >= 0 && v < (int)board.size();
+    int n = (int)board.size();
+    int subgrid = subgrid_size;
+    job = Job::Solve;
+    job_puzzle = board;
+    job_solution = board;
+    bool follow = gui.watch_solver;
+    parallel::SearchSnapshot stale;
+    while(watch.take_latest(stale)) {} // Left over from an earlier solve
+    task.start([this, n, subgrid, follow](parallel::Progress& progress)
+    {
+        timing::Stopwatch stopwatch;
+        if(follow) progress.watch = &watch;
+        // Its own table, the board may be resized meanwhile
+        std::unique_ptr<solver::SubgridLut[]> lut(new solver::SubgridLut[1]);
+        solver::fill_subgrid_lut(lut[0], n, subgrid);
+        job_stats.clear();
+        job_result = solver::solve(job_solution, subgrid, lut[0], &pool, &progress, &job_stats);
+        job_ms = stopwatch.elapsed_ms();
+    });
 }
 
-bool Game::is_solved()
+void Game::generate_puzzle(int level)
 {
-    int n = board.size();
-    BoolBoard seen_row, seen_col, seen_subgrid;
-    seen_row.resize(n, std::vector<bool>(n, false));
-    seen_col.resize(n, std::vector<bool>(n, false));
-    seen_subgrid.resize(n, std::vector<bool>(n, false));
-
-    for(int row = 0; row < n; ++row)
+    if(task.running())
     {
-        for(int col = 0; col < n; ++col)
-        {
-            int subgrid = subgrid_lut[row][col];
-            int num = board[row][col] - 1;
-            if(num == -1 || seen_row[row][num] || seen_col[col][num] || seen_subgrid[subgrid][num]) 
-            {
-                return false;
-            }
-            seen_row[row][num] = true;
-            seen_col[col][num] = true;
-            seen_subgrid[subgrid][num] = true;
-        }
+        gui.pop_up_message("Busy, press Stop first");
+        return;
     }
-    return true;
-}
-
-void Game::fit_known_solution_vec()
-{
-    known_solution.assign(board.size(), std::vector<int>(board.size(), 0));
-}
 
-void Game::set_from_puzzle_as_state()
-{
-    int n = board.size();
-    for(int row = 0; row < n; ++row)
-    {
-        for(int col = 0; col < n; ++col)
+    int n = (int)board.size();
+    job = Job::Generate;
+    task.start([this, n, level](parallel::Progress& progress)
+    {
+        timing::Stopwatch stopwatch;
+        generator::SudokuGenerator generator(n);
+        generator.set_progress(&progress);
+        if(n >= PARALLEL_GENERATE_SIZE) generator.set_pool(&pool);
+        job_short = false;
+        if(n <= MAX_RATING_SIZE)
         {
-            if(board[row][col] != 0) from_puzzle[row][col] = true;
-            else from_puzzle[row][col] = false;
+            generator.generate_rated(level, job_puzzle, job_solution);
         }
-    }
+        else
+        {
+            // Uncapped uniqueness checks would take hours on these boards
+            job_short = !generator.generate_puzzle(generator::clues_for_level(level, n), job_puzzle, job_solution, 4LL * n);
+        }
+        job_ms = stopwatch.elapsed_ms();
+    });
 }
 
-bool Game::solver(Board &board, int row, int col, 
-                   BitBoard seen_row[MAX_SOLVE_SIZE], 
-                   BitBoard seen_col[MAX_SOLVE_SIZE], 
-                   BitBoard seen_subgrid[MAX_SOLVE_SIZE], int n)
+void Game::finish_job()
 {
-    if (row == n)
-    {
-        return true;
-    }
-
-    if (col == n)
-    {
-        return solver(board, row + 1, 0, seen_row, seen_col, seen_subgrid, n);
-    }
-
-    if (board[row][col] != 0)
-    {
-        return solver(board, row, col + 1, seen_row, seen_col, seen_subgrid, n);
-    }
-
-    int subgrid = subgrid_lut[row][col];
-
-    BitBoard seen = seen_row[row] | seen_col[col] | seen_subgrid[subgrid];
-    BitBoard options = (~seen) & ((BitBoard(1) << n) - 1); // Mask to ensure only valid numbers (0 to n - 1) are considered.
+    if(!task.take_finished()) return;
+    gui.needs_present = true; // Whatever happened below shows in the next frame
 
-    while (options)
+    Job finished = job;
+    job = Job::None;
+    if(finished == Job::Generate)
     {
-        int index = __builtin_ctz(options);
-
-        BitBoard index_mask = BitBoard(1) << index;
-        board[row][col] = index + 1; // convert index to an option
-        seen_row[row]         |= index_mask;
-        seen_col[col]         |= index_mask;
-        seen_subgrid[subgrid] |= index_mask;
-
-        if (solver(board, row, col + 1, seen_row, seen_col, seen_subgrid, n))
+        // A stopped generator returns a puzzle with too many clues, it is dropped
+        if(task.progress().cancelled())
         {
-            return true;
+            gui.pop_up_message("Stopped", 1500, {144, 0, 0});
+            return;
         }
-
-        board[row][col] = 0;
-        seen_row[row]         &= ~index_mask;
-        seen_col[col]         &= ~index_mask;
-        seen_subgrid[subgrid] &= ~index_mask;
-
-        options &= (options - 1);
+        gui.generate_times.add(job_ms);
+        if(job_puzzle.size() == board.size()) set_puzzle(job_puzzle, job_solution);
+        if(job_short) gui.pop_up_message("More clues than the level asks", 2000, {0, 0, 144});
+        return;
     }
 
-    return false;
-}
-
-void Game::solve_board()
-{
-    int n = (int)board.size();
-    if(n > MAX_SOLVE_SIZE)
+    if(job_result == solver::Result::Cancelled)
     {
-        gui.pop_up_message("AI solving is limited to a size of " + std::to_string(MAX_SOLVE_SIZE));
+        gui.pop_up_message("Stopped", 1500, {144, 0, 0});
         return;
     }
-
-    BitBoard seen_row[MAX_SOLVE_SIZE]     = { 0 };
-    BitBoard seen_col[MAX_SOLVE_SIZE]     = { 0 };
-    BitBoard seen_subgrid[MAX_SOLVE_SIZE] = { 0 };
-
-    for(int row = 0; row < n; ++row)
+    gui.solve_times.add(job_ms); // Stopped jobs are left out of the timings
+    gui.solve_nodes = task.progress().nodes.load(std::memory_order_relaxed);
+    gui.solve_stats = job_stats;
+    if(job_result == solver::Result::Invalid)
     {
-        for(int col = 0; col < n; ++col)
-        {
-            int num = board[row][col];
-            if(num == 0) continue;
-            
-            int index = num -1;
-            int index_mask = (1 << index);
-
-            int subgrid = subgrid_lut[row][col];
-            BitBoard seen = seen_row[row] | seen_col[col] | seen_subgrid[subgrid];
-
-
-            if(seen & index_mask)
-            {
-                gui.pop_up_message("Invalid State", 1500, {144, 0, 0});
-                return;
-            }
-
-            seen_row[row] |= index_mask;
-            seen_col[col] |= index_mask;
-            seen_subgrid[subgrid] |= index_mask;
-            from_puzzle[row][col] = true;
-        }
+        gui.pop_up_message("Invalid State", 1500, {144, 0, 0});
     }
-
-    if(solver(board, 0, 0, seen_row, seen_col, seen_subgrid, n))
+    else if(job_result == solver::Result::Unsolvable)
     {
-        // is_solution_known = true;
-        // fit_known_solution_vec();
-        // copy_board(board, known_solution);
-
-        // This is half good half bad (in one case its bad), i just left it
+        gui.pop_up_message("Unsolvable Board", 1500, {144, 0, 0});
     }
-    else 
+    else if(job_result == solver::Result::Solved && !commit_solution(job_puzzle, job_solution))
     {
-        gui.pop_up_message("Unsolvable Board", 1500, {144, 0, 0});
+        gui.pop_up_message("The board changed while solving", 1500, {144, 0, 0});
     }
 }
-
-const std::unordered_map<int, int> Game::subgrid_size_map = 
-{
-    {4, 2}, {9, 3}, {16, 4}, {25, 5}, {36, 6}, {49, 7}, {64, 8}, {81, 9}, {100, 10}
-};
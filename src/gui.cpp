@@ -2,15 +2,18 @@
 #include "gui.hpp"
 #include "game.hpp"
 #include "generator.hpp"
+#include <cmath>
+#include <cstdio>
 
 Gui::Gui(Game* game): 
     window(sf::VideoMode(board_size + left_side_width, board_size), "")
 {
     if(!game) std::__throw_runtime_error("Gui must be initialized with a game");
+    font.loadFromFile("soft.ttf"); // Before set_game, the glyph atlas is rendered with it
+    OkButton::font = font;
+    board_layer.create(board_size, board_size);
     set_game(game);
     window.setFramerateLimit(28);
-    font.loadFromFile("soft.ttf");
-    OkButton::font = font;
     initialize_buttons();
 }
 
@@ -27,202 +30,349 @@ void Gui::update()
 
 void Gui::render()
 {
-    window.clear();
-    render_board();
-    render_left_side();
-    render_messages();
-    window.display();
+    filter_messages();
+    {
+        timing::ScopedTimer layer_timer(timer(layer_times));
+        update_board_layer();
+    }
+
+    if(watching_search() && game->watch.take_latest(snapshot)) needs_present = true;
+
+    // Pop-up messages and background jobs get a frame every tick until they are gone
+    sf::Vector2i hover = hovered_cell();
+    bool job_shown = game->task.running() || drawn_job;
+    if(hover != drawn_hover || current_selected_cell != drawn_selected || !messages.empty() || drawn_messages || job_shown)
+    {
+        needs_present = true;
+    }
+    if(!needs_present) return;
+
+    {
+        timing::ScopedTimer frame_timer(timer(frame_times));
+        window.clear();
+        {
+            timing::ScopedTimer board_timer(timer(board_times));
+            render_board();
+        }
+        {
+            timing::ScopedTimer panel_timer(timer(panel_times));
+            render_left_side();
+        }
+        render_progress();
+        render_timings();
+        render_messages();
+    }
+    window.display(); // Waits out the frame limit, so it is left out of frame_times
+    if(timings_shown) draw_counts.add(frame_draws);
+    frame_draws = 0;
+
+    needs_present = false;
+    drawn_job = game->task.running();
+    drawn_hover = hover;
+    drawn_selected = current_selected_cell;
+    drawn_messages = messages.size();
 }
 
 void Gui::input()
 {
+    // With nothing to animate the loop sleeps here until the next event
     sf::Event e;
-    while(window.pollEvent(e))
+    // A job sets finished before it stops running, so one of the two is seen
+    // and a job ending right now is still picked up by the next finish_job
+    bool idle = messages.empty() && !needs_present && !drawn_job && !game->task.running() && !game->task.has_finished();
+    bool has_event = idle ? window.waitEvent(e) : window.pollEvent(e);
+    while(has_event)
     {
-        auto mp = sf::Mouse::getPosition(window);
-        mouse_position = { (float)mp.x, (float)mp.y };
-        if(e.type == sf::Event::Closed)
+        timing::ScopedTimer input_timer(timer(input_times));
+        handle_event(e);
+        has_event = window.pollEvent(e);
+    }
+}
+
+void Gui::handle_event(const sf::Event& e)
+{
+    auto mp = sf::Mouse::getPosition(window);
+    mouse_position = { (float)mp.x, (float)mp.y };
+    if(e.type != sf::Event::MouseMoved) needs_present = true; // Moves only matter when the hovered cell changes
+    if(e.type == sf::Event::Closed)
+    {
+        game->running = false;
+    }
+    else if(e.type == sf::Event::MouseButtonPressed)
+    {
+        if(e.mouseButton.button == 0)
         {
-            game->running = false;
+            handle_left_click();
         }
-        else if(e.type == sf::Event::MouseButtonPressed)
+        else if(e.mouseButton.button == 1)
+        {
+            handle_right_click();
+        }
+    }       
+    else if(e.type == sf::Event::MouseButtonReleased)
+    {
+        if(e.mouseButton.button == 0)
         {
-            if(e.mouseButton.button == 0)
+            handle_left_release();
+        }
+        else if(e.mouseButton.button == 1)
+        {
+            handle_right_release();
+        }
+    }
+    else if(e.type == sf::Event::KeyPressed)
+    {
+        if(e.key.code == sf::Keyboard::F3)
+        {
+            toggle_timings();
+        }
+        if(e.key.code == sf::Keyboard::F4)
+        {
+            watch_solver = !watch_solver;
+            pop_up_message(watch_solver ? "Watching the next solve" : "Not watching solves");
+        }
+        if(e.key.code == sf::Keyboard::Enter)
+        {
+            if(current_button)
             {
-                handle_left_click();
+                current_button->on_ok(this);
             }
-            else if(e.mouseButton.button == 1)
+        }
+        if(e.key.code == sf::Keyboard::Right || e.key.code == sf::Keyboard::D)
+        {
+            current_selected_cell.x = (current_selected_cell.x + 1) % game->board.size();
+        }
+        else if(current_selected_cell.x != -1)
+        {
+            if(e.key.code == sf::Keyboard::Left || e.key.code == sf::Keyboard::A)
             {
-                handle_right_click();
+                current_selected_cell.x = (current_selected_cell.x - 1) % game->board.size();
             }
-        }       
-        else if(e.type == sf::Event::MouseButtonReleased)
-        {
-            if(e.mouseButton.button == 0)
+            else if(e.key.code == sf::Keyboard::Up || e.key.code == sf::Keyboard::W)
             {
-                handle_left_release();
+                current_selected_cell.y = (current_selected_cell.y - 1) % game->board.size();
             }
-            else if(e.mouseButton.button == 1)
+            else if(e.key.code == sf::Keyboard::Down || e.key.code == sf::Keyboard::S)
             {
-                handle_right_release();
+                current_selected_cell.y = (current_selected_cell.y + 1) % game->board.size();
+            }
+            else if(e.key.code == sf::Keyboard::BackSpace || e.key.code == sf::Keyboard::Delete)
+            {
+                game->set_cell(current_selected_cell.y, current_selected_cell.x, 0);
             }
         }
-        else if(e.type == sf::Event::KeyPressed)
+    }
+    else if(e.type == sf::Event::TextEntered)
+    {
+        int n = game->board.size();
+        auto c = e.text.unicode;
+        int i_c = c - '0';
+        std::string i_s = std::to_string(i_c);
+        if(c < '0' || c > '9') return;
+        if(current_button)
         {
-            if(e.key.code == sf::Keyboard::Enter)
+            if(current_button->id == 1)
             {
-                if(current_button)
+                auto s = current_button->ok_str;
+                auto res = s + i_s;
+                if((!res.empty() && res[0] == '0') || (res != "10" && res != "100" && !game->is_valid_board_size(std::stoi(res)))) 
                 {
-                    current_button->on_ok(this);
+                    current_button->set_ok(i_s);
                 }
+                else current_button->set_ok(res);
             }
-            if(e.key.code == sf::Keyboard::Right || e.key.code == sf::Keyboard::D)
-            {
-                current_selected_cell.x = (current_selected_cell.x + 1) % game->board.size();
-            }
-            else if(current_selected_cell.x != -1)
+            else if(current_button->id == 3)
             {
-                if(e.key.code == sf::Keyboard::Left || e.key.code == sf::Keyboard::A)
-                {
-                    current_selected_cell.x = (current_selected_cell.x - 1) % game->board.size();
-                }
-                else if(e.key.code == sf::Keyboard::Up || e.key.code == sf::Keyboard::W)
+                if(i_c >= 1 && i_c <= 5)
                 {
-                    current_selected_cell.y = (current_selected_cell.y - 1) % game->board.size();
-                }
-                else if(e.key.code == sf::Keyboard::Down || e.key.code == sf::Keyboard::S)
-                {
-                    current_selected_cell.y = (current_selected_cell.y + 1) % game->board.size();
-                }
-                else if(e.key.code == sf::Keyboard::BackSpace || e.key.code == sf::Keyboard::Delete)
-                {
-                    game->board[current_selected_cell.y][current_selected_cell.x] = 0;
+                    current_button->set_ok(i_s);
                 }
             }
         }
-        else if(e.type == sf::Event::TextEntered)
+        else if(i_c <= n && current_selected_cell.x != -1 && !game->from_puzzle[current_selected_cell.y][current_selected_cell.x])
         {
-            int n = game->board.size();
-            auto c = e.text.unicode;
-            int i_c = c - '0';
-            std::string i_s = std::to_string(i_c);
-            if(c < '0' || c > '9') continue;
-            if(current_button)
+            auto current = game->board[current_selected_cell.y][current_selected_cell.x];
+            int results = current * 10 + i_c;
+            if(results > n) game->set_cell(current_selected_cell.y, current_selected_cell.x, i_c);
+            else 
             {
-                if(current_button->id == 1)
-                {
-                    auto s = current_button->ok_str;
-                    auto res = s + i_s;
-                    if((!res.empty() && res[0] == '0') || (res != "10" && res != "100" && !game->is_valid_board_size(std::stoi(res)))) 
-                    {
-                        current_button->set_ok(i_s);
-                    }
-                    else current_button->set_ok(res);
-                }
-                else if(current_button->id == 3)
-                {
-                    if(i_c >= 1 && i_c <= 5)
-                    {
-                        current_button->set_ok(i_s);
-                    }
-                }
-            }
-            else if(i_c <= n && current_selected_cell.x != -1 && !game->from_puzzle[current_selected_cell.y][current_selected_cell.x])
-            {
-                auto current = game->board[current_selected_cell.y][current_selected_cell.x];
-                int results = current * 10 + i_c;
-                if(results > n) game->board[current_selected_cell.y][current_selected_cell.x] = i_c;
-                else 
-                {
-                    game->board[current_selected_cell.y][current_selected_cell.x] = results;
-                }
+                game->set_cell(current_selected_cell.y, current_selected_cell.x, results);
             }
-
         }
+
     }
 }
 
 void Gui::render_board()
 {
     static sf::RectangleShape rect({1, 1});
-    static sf::Color light(244, 244, 244);
-    static sf::Color dark(233, 233, 233);
-    
-    static sf::RectangleShape subgrid_h_line({1, 3}); 
-    static sf::RectangleShape subgrid_v_line({3, 1});
+    rect.setSize({square_size, square_size});
 
-    rect.setOutlineColor({192, 192, 192});
-    rect.setOutlineThickness(1);
-    subgrid_h_line.setFillColor({64, 64, 64}); 
-    subgrid_v_line.setFillColor({64, 64, 64});
+    draw(window, sf::Sprite(board_layer.getTexture()));
+    render_snapshot();
 
-    static sf::Text text("0", font);
+    if(current_selected_cell.x != -1)
+    {
+        rect.setFillColor({10, 10, 200, 40});
+        rect.setOutlineThickness(0);
+        rect.setPosition(current_selected_cell.x * square_size, current_selected_cell.y * square_size);
+        draw(window, rect);
+    }
 
-    if ((int)rect.getGlobalBounds().getSize().x != (int)square_size)
+    sf::Vector2i highlight_square = hovered_cell();
+    if(highlight_square != current_selected_cell && highlight_square.x != -1)
     {
-        rect.setSize({square_size, square_size});
-        subgrid_h_line.setSize({square_size * game->board.size(), 2});
-        subgrid_v_line.setSize({2, square_size * game->board.size()});
-        text.setCharacterSize(square_size * 0.5f);
+        rect.setFillColor({10, 10, 200, 20});
+        rect.setOutlineThickness(0);
+        rect.setPosition(highlight_square.x * square_size, highlight_square.y * square_size);
+        draw(window, rect);
     }
+}
 
+void Gui::build_board_grid()
+{
     int n = game->board.size();
     int subgrid = game->subgrid_size;
-    bool subgrid_toggle = false;
+    float side = square_size * n;
+    sf::Color light(244, 244, 244);
+    sf::Color dark(233, 233, 233);
+    sf::Color line(192, 192, 192);
+    sf::Color subgrid_line(64, 64, 64);
 
+    board_grid.clear();
     for (int row = 0; row < n; ++row)
     {
-        bool row_subgrid_toggle = subgrid_toggle;
-
         for (int col = 0; col < n; ++col)
         {
-            int c = game->board[row][col];
-            float x = col * square_size;
-            float y = row * square_size;
-            text.setString(c > 0 ? std::to_string(c) : "");
-            if(game->from_puzzle[row][col]) text.setFillColor({0, 0, 255});
-            else text.setFillColor({0, 0, 0});
-            center_text(text, {x + square_size / 2.0f, y + square_size / 2.0f});
-
-            rect.setPosition(x, y);
-            rect.setFillColor(row_subgrid_toggle ? light : dark);
-            window.draw(rect);
-
-            if (c)window.draw(text);
-
-            row_subgrid_toggle = !row_subgrid_toggle;
+            add_quad(board_grid, {col * square_size, row * square_size, square_size, square_size}, (row + col) % 2 ? dark : light);
         }
-
-        subgrid_toggle = !subgrid_toggle;
     }
-
+    for (int i = 0; i <= n; ++i)
+    {
+        float pos = i * square_size;
+        add_quad(board_grid, {pos - 0.5f, 0, 1, side}, line);
+        add_quad(board_grid, {0, pos - 0.5f, side, 1}, line);
+    }
     for (int i = 1; i < n / subgrid; ++i)
     {
         float pos = i * subgrid * square_size;
+        add_quad(board_grid, {pos, 0, 2, side}, subgrid_line);
+        add_quad(board_grid, {0, pos, side, 2}, subgrid_line);
+    }
+}
 
-        subgrid_v_line.setPosition(pos, 0);
-        window.draw(subgrid_v_line);
+void Gui::build_glyph_atlas()
+{
+    int n = game->board.size();
+    atlas_slot = std::max(1, (int)std::ceil(square_size));
+    atlas_columns = (int)std::ceil(std::sqrt((float)n));
+    int atlas_rows = (n + atlas_columns - 1) / atlas_columns;
+
+    glyph_atlas.create(atlas_columns * atlas_slot, atlas_rows * atlas_slot);
+    glyph_atlas.setSmooth(true); // Slots are a fraction of a pixel bigger than the squares
+    glyph_atlas.clear(sf::Color::Transparent);
+
+    // White glyphs take the vertex color, so one atlas serves given and typed numbers
+    sf::Text text("", font, square_size * 0.5f);
+    text.setFillColor(sf::Color::White);
+    for (int num = 1; num <= n; ++num)
+    {
+        int slot = num - 1;
+        text.setString(std::to_string(num));
+        center_text(text, {(slot % atlas_columns + 0.5f) * atlas_slot, (slot / atlas_columns + 0.5f) * atlas_slot});
+        draw(glyph_atlas, text);
+    }
+    glyph_atlas.display();
+}
+
+void Gui::build_board_digits(int row0, int row1, int col0, int col1)
+{
+    sf::Color given(0, 0, 255);
+    sf::Color typed(0, 0, 0);
+    sf::Color conflict(208, 0, 0);
 
-        subgrid_h_line.setPosition(0, pos);
-        window.draw(subgrid_h_line);
+    board_digits.clear(); // Keeps its storage, so this allocates only when the board fills up
+    for (int row = row0; row <= row1; ++row)
+    {
+        const auto* cells = game->board[row];
+        const auto* fixed = game->from_puzzle[row];
+        for (int col = col0; col <= col1; ++col)
+        {
+            int c = cells[col];
+            if (!c) continue;
+            int slot = c - 1;
+            sf::FloatRect tex((slot % atlas_columns) * atlas_slot, (slot / atlas_columns) * atlas_slot, atlas_slot, atlas_slot);
+            sf::Color color = game->conflicts(row, col) ? conflict : fixed[col] ? given : typed;
+            add_quad(board_digits, {col * square_size, row * square_size, square_size, square_size}, color, tex);
+        }
     }
-    
-    if(current_selected_cell.x != -1)
+}
+
+void Gui::update_board_layer()
+{
+    int n = game->board.size();
+    int row0 = 0, row1 = n - 1, col0 = 0, col1 = n - 1;
+    if(!board_layer_stale)
     {
-        rect.setFillColor({10, 10, 200, 40});
-        rect.setOutlineThickness(0);
-        rect.setPosition(current_selected_cell.x * square_size, current_selected_cell.y * square_size);
-        window.draw(rect);
+        // Bounding block of the cells whose value, given flag or conflict changed.
+        // A write can change the conflicts of its whole row, column and box.
+        row0 = col0 = n;
+        row1 = col1 = -1;
+        for (int row = 0; row < n; ++row)
+        {
+            for (int col = 0; col < n; ++col)
+            {
+                if(game->board[row][col] != drawn_board[row][col] || game->from_puzzle[row][col] != drawn_fixed[row][col] ||
+                   game->conflicts(row, col) != (bool)drawn_conflicts[row][col])
+                {
+                    row0 = std::min(row0, row);
+                    row1 = std::max(row1, row);
+                    col0 = std::min(col0, col);
+                    col1 = std::max(col1, col);
+                }
+            }
+        }
+        if(row1 < 0) return;
     }
 
-    sf::Vector2i highlight_square = {(int)mouse_position.x / (int)square_size, (int)mouse_position.y / (int)square_size};
-    if(highlight_square != current_selected_cell && game->in_range(highlight_square.x) && game->in_range(highlight_square.y))
+    // A view over the whole pixels of the block, with the same viewport, clips
+    // drawing to it; everything outside keeps the previous frame
+    float left = std::floor(col0 * square_size);
+    float top = std::floor(row0 * square_size);
+    float right = std::min((float)board_size, std::ceil((col1 + 1) * square_size));
+    float bottom = std::min((float)board_size, std::ceil((row1 + 1) * square_size));
+    sf::View view({left, top, right - left, bottom - top});
+    view.setViewport({left / board_size, top / board_size, (right - left) / board_size, (bottom - top) / board_size});
+
+    // Rounding out can take in a sliver of the neighbours, so their digits come too
+    build_board_digits(std::max(0, row0 - 1), std::min(n - 1, row1 + 1), std::max(0, col0 - 1), std::min(n - 1, col1 + 1));
+    board_layer.setView(view);
+    draw(board_layer, board_grid);
+    draw(board_layer, board_digits, &glyph_atlas.getTexture());
+    board_layer.display();
+
+    drawn_board = game->board;
+    drawn_fixed = game->from_puzzle;
+    if((int)drawn_conflicts.size() != n) drawn_conflicts.assign(n);
+    for (int row = row0; row <= row1; ++row)
     {
-        rect.setFillColor({10, 10, 200, 20});
-        rect.setOutlineThickness(0);
-        rect.setPosition(highlight_square.x * square_size, highlight_square.y * square_size);
-        window.draw(rect);
+        for (int col = col0; col <= col1; ++col)
+        {
+            drawn_conflicts[row][col] = game->conflicts(row, col);
+        }
     }
+    board_layer_stale = false;
+    needs_present = true;
+}
+
+sf::Vector2i Gui::hovered_cell() const
+{
+    sf::Vector2i cell = {(int)mouse_position.x / (int)square_size, (int)mouse_position.y / (int)square_size};
+    if(mouse_position.x < 0 || mouse_position.y < 0 || !game->in_range(cell.x) || !game->in_range(cell.y))
+    {
+        return {-1, -1};
+    }
+    return cell;
 }
 
 void Gui::render_left_side()
@@ -230,15 +380,142 @@ void Gui::render_left_side()
     if(current_button) current_button->high_light = true;
     for(auto& button: buttons)
     {
-        button.draw(window);
+        button.draw(this);
     }
     if(current_button) current_button->high_light = false;
 }
 
+bool Gui::watching_search() const
+{
+    return watch_solver && game->task.running() && game->job == Game::Job::Solve;
+}
+
+void Gui::render_snapshot()
+{
+    int n = game->board.size();
+    if(!watching_search() || (int)snapshot.board.size() != n) return;
+
+    sf::Color placed(0, 150, 60);
+    snapshot_digits.clear();
+    for (int row = 0; row < n; ++row)
+    {
+        const auto* cells = snapshot.board[row];
+        const auto* shown = game->board[row];
+        for (int col = 0; col < n; ++col)
+        {
+            int c = cells[col];
+            if (!c || shown[col]) continue;
+            int slot = c - 1;
+            sf::FloatRect tex((slot % atlas_columns) * atlas_slot, (slot / atlas_columns) * atlas_slot, atlas_slot, atlas_slot);
+            add_quad(snapshot_digits, {col * square_size, row * square_size, square_size, square_size}, placed, tex);
+        }
+    }
+    draw(window, snapshot_digits, &glyph_atlas.getTexture());
+
+    if(snapshot.cell >= 0)
+    {
+        static sf::RectangleShape rect({1, 1});
+        rect.setSize({square_size, square_size});
+        rect.setFillColor({255, 140, 0, 90});
+        rect.setPosition((snapshot.cell % n) * square_size, (snapshot.cell / n) * square_size);
+        draw(window, rect);
+    }
+}
+
+void Gui::render_progress()
+{
+    if(!game->task.running()) return;
+
+    const auto& progress = game->task.progress();
+    int cells = game->board.size() * game->board.size();
+    std::string str;
+    if(game->job == Game::Job::Solve)
+    {
+        str = "Solving\n" + std::to_string(progress.nodes.load(std::memory_order_relaxed)) + " nodes\n" +
+              std::to_string(progress.cells.load(std::memory_order_relaxed)) + " / " + std::to_string(cells) + " cells";
+        if(watching_search()) str += "\ndepth " + std::to_string(snapshot.depth);
+    }
+    else
+    {
+        str = "Generating\n" + std::to_string(progress.cells.load(std::memory_order_relaxed)) + " clues removed";
+    }
+
+    sf::Text text(str, font, 20);
+    text.setFillColor({255, 255, 255});
+    text.setPosition(board_size + 60.0f, 660.0f); // Under the last button
+    draw(window, text);
+}
+
+void Gui::render_timings()
+{
+    if(!timings_shown) return;
+
+    char line[96];
+    std::string str;
+    auto add_times = [&](const char* name, const timing::Histogram& histogram)
+    {
+        std::snprintf(line, sizeof(line), "%-6s %6.2f %6.2f %6.2f\n", name,
+                      histogram.percentile(50), histogram.percentile(99), histogram.max());
+        str += line;
+    };
+    str += "ms      p50    p99    max\n";
+    add_times("frame", frame_times);
+    add_times("layer", layer_times);
+    add_times("board", board_times);
+    add_times("panel", panel_times);
+    add_times("input", input_times);
+    std::snprintf(line, sizeof(line), "draws  %6.0f %6.0f %6.0f\n",
+                  draw_counts.percentile(50), draw_counts.percentile(99), draw_counts.max());
+    str += line;
+    if(solve_times.count())
+    {
+        std::snprintf(line, sizeof(line), "solve  %.1f ms  %lld nodes\n", solve_times.last(), solve_nodes);
+        str += line;
+        if(solver::SearchStats::enabled)
+        {
+            bool dlx = solve_stats.rows_covered > 0; // Dancing Links forces no cells, its work is in covers
+            std::snprintf(line, sizeof(line), "       %lld back  %d deep  %lld %s\n", solve_stats.backtracks, solve_stats.max_depth,
+                          dlx ? solve_stats.rows_covered : solve_stats.forced, dlx ? "rows" : "forced");
+            str += line;
+            str += "depth ";
+            for(std::size_t depth = 0; depth < solve_stats.branches.size() && depth < 6; ++depth)
+            {
+                str += " " + std::to_string(solve_stats.branches[depth]); // Branches taken at the first decisions
+            }
+            str += "\n";
+        }
+    }
+    if(generate_times.count())
+    {
+        std::snprintf(line, sizeof(line), "puzzle %.1f ms\n", generate_times.last());
+        str += line;
+    }
+
+    sf::Text text(str, font, 14);
+    text.setFillColor({160, 255, 160});
+    text.setPosition(board_size + 20.0f, 710.0f); // Room for the search lines above the window's bottom
+    draw(window, text);
+}
+
+void Gui::toggle_timings()
+{
+    timings_shown = !timings_shown;
+    // Each showing starts from fresh samples, old ones would be from another board
+    for(auto* histogram : {&frame_times, &layer_times, &board_times, &panel_times, &input_times, &draw_counts})
+    {
+        histogram->clear();
+    }
+}
+
+void Gui::draw(sf::RenderTarget& target, const sf::Drawable& drawable, const sf::RenderStates& states)
+{
+    target.draw(drawable, states);
+    ++frame_draws;
+}
+
 void Gui::render_messages()
 {
     sf::Text text("", font);
-    filter_messages();
     for(auto& m: messages)
     {
         // auto time_left = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m.time_start).count();
@@ -252,7 +529,7 @@ void Gui::render_messages()
         text.setOutlineColor({255, 255, 255});
         text.setString(m.str);
         center_text(text, m.center);
-        window.draw(text);
+        draw(window, text);
     }
 }
 
@@ -319,6 +596,9 @@ void Gui::set_game(Game *game)
 void Gui::update_by_board_size()
 {
     square_size = board_size / (float)game->board.size();
+    build_board_grid();
+    build_glyph_atlas();
+    board_layer_stale = true;
 }
 
 void Gui::pop_up_message(const std::string &str, int milliseconds, const sf::Color& color)
@@ -369,18 +649,6 @@ void Gui::refresh()
     current_selected_cell.x = -1;
 }
 
-int number_of_clues(int level, int board_size)  
-{  
-    int total_cells = board_size * board_size;  
-    int min_clues = total_cells / 4 + 1;  
-
-    level = std::max(1, std::min(level, 5));
-
-    double clue_percentages[5] = { 0.85, 0.75, 0.60, 0.45, 0.25 };
-
-    return (int)std::max(min_clues, static_cast<int>(total_cells * clue_percentages[level - 1]));
-}
-
 void Gui::initialize_buttons()
 {
     auto& clear = add_button("Clear", "-->", 0);
@@ -413,23 +681,13 @@ void Gui::initialize_buttons()
     solver.set_on_click([](OkButton& self, Gui* gui)
     {
         gui->refresh();
-        Game* game = gui->game;
-        if(game->is_solution_known)
-        {
-            game->copy_board(game->known_solution, game->board);
-        }
-        else gui->game->solve_board();
+        if(!gui->game->fill_known_solution()) gui->game->solve_board();
     });
 
     auto& puzzle = add_button("Puzzle", "1-5", 3);
     puzzle.set_on_click([](OkButton& self, Gui* gui)
     {
         int n = gui->game->board.size();
-        if(n > MAX_SOLVE_SIZE)
-        {
-            gui->pop_up_message("AI support end at size " + std::to_string(MAX_SOLVE_SIZE));
-            return;
-        }
         if(self.ok_str.empty()) return;
         for(auto c: self.ok_str) 
         {
@@ -439,31 +697,32 @@ void Gui::initialize_buttons()
                 return;
             }
         }
-        gui->pop_up_message("Generating Puzzle...", 5);
-        gui->render();
-        int l = std::stoi(self.ok_str);
-        gui->game->board = generator::SudokuGenerator(n).generate_puzzle(number_of_clues(l, n), gui->game->known_solution);
-        gui->game->is_solution_known = true;
-        gui->game->set_from_puzzle_as_state();
+        int l = std::max(1, std::min(std::stoi(self.ok_str), 5));
+        generator::Puzzle puzzle;
         self.set_ok("1-5");
         gui->refresh();
+        if(gui->game->puzzles.try_take(n, l, puzzle) || gui->game->bank.take(n, l, puzzle))
+        {
+            gui->game->set_puzzle(puzzle.puzzle, puzzle.solution);
+        }
+        else
+        {
+            gui->game->generate_puzzle(l); // Nothing ready, the board is filled when it is done
+        }
     });
 
     auto& reset = add_button("Reset", "-->", 4);
     reset.set_on_click([](OkButton& self, Gui* gui)
     {
         gui->refresh();
-        int n = (int)gui->game->board.size();
-        for(int row = 0; row < n; ++row)
-        {
-            for(int col = 0; col < n; ++col)
-            {
-                if(!gui->game->from_puzzle[row][col])
-                {
-                    gui->game->board[row][col] = 0;
-                }
-            }
-        }
+        gui->game->reset_board();
+    });
+
+    auto& stop = add_button("Stop", "-->", 6);
+    stop.set_on_click([](OkButton& self, Gui* gui)
+    {
+        gui->refresh();
+        if(gui->game->task.running()) gui->game->task.cancel();
     });
 
     auto& submit = add_button("Submit", "-->", 5);
@@ -488,6 +747,18 @@ void Gui::center_text(sf::Text& text, sf::Vector2f center)
     text.setPosition(center.x, center.y);
 }
 
+void Gui::add_quad(sf::VertexArray& quads, sf::FloatRect rect, sf::Color color, sf::FloatRect tex)
+{
+    float right = rect.left + rect.width;
+    float bottom = rect.top + rect.height;
+    float tex_right = tex.left + tex.width;
+    float tex_bottom = tex.top + tex.height;
+    quads.append(sf::Vertex({rect.left, rect.top}, color, {tex.left, tex.top}));
+    quads.append(sf::Vertex({right, rect.top}, color, {tex_right, tex.top}));
+    quads.append(sf::Vertex({right, bottom}, color, {tex_right, tex_bottom}));
+    quads.append(sf::Vertex({rect.left, bottom}, color, {tex.left, tex_bottom}));
+}
+
 OkButton::OkButton(sf::Vector2f position): 
     position(position)
 {
@@ -503,7 +774,7 @@ void OkButton::set_ok(const std::string &text)
     ok_str = text;
 }
 
-void OkButton::draw(sf::RenderWindow &window)
+void OkButton::draw(Gui* gui)
 {
     static sf::Text text("0", font, 20);
     static sf::RectangleShape rect(rect_size);
@@ -517,8 +788,8 @@ void OkButton::draw(sf::RenderWindow &window)
     Gui::center_text(text, {position.x +  rect_size.x / 2.0f, position.y + rect_size.y / 2.0f});
     rect.setPosition(position);
 
-    window.draw(rect);
-    window.draw(text);
+    gui->draw(gui->window, rect);
+    gui->draw(gui->window, text);
 
     text.setString(str);
 
@@ -527,8 +798,8 @@ void OkButton::draw(sf::RenderWindow &window)
     rect.setPosition(next_position);
 
 
-    window.draw(rect);
-    window.draw(text);
+    gui->draw(gui->window, rect);
+    gui->draw(gui->window, text);
 }
 
 bool OkButton::contains(sf::Vector2f point)
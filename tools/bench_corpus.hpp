@@ -0,0 +1,96 @@
+#pragma once
+
+// Puzzles for sudoku-bench, in the one-line format of puzzle_io.hpp. All have
+// exactly one solution. The generated sets were made once with
+// SudokuGenerator seeded with 20240101 + size, so they stay fixed while the
+// generator changes; the 9x9 hard and 17-clue puzzles are well-known ones.
+namespace bench
+{
+    // Level 1: hidden singles solve them
+    const char* const easy9[] =
+    {
+        "14536897239672.4182781.95.3.6198723553.2.468.9825.67416248..3578.947312..13652894",
+        "4329.716.1594362787861.234..7.643821.2389.4578142.56935983247162675.893.3.1.69582",
+        ".297.65.37318452695643..78148253197.917264.5.356978.2.1456928.767815349229.4.7615",
+        "7.52498..84.57.1292936.174513985467..24.1735857832691448173259695.46.23136219..87",
+        "84935761.62589...43712.6958.82435176..4968.2553671284915867429.46.12958.297583.61",
+        "8695473211.782.459452139786.843.21673.5674298726.8154.27.49361.54176893269.2..8.4",
+        "..91.647275182469326.7398158.694.357943578.2617526.9844923.5.615.8617.49617492.38",
+        "95.42687.68..574.27428391651265.873949.61.528835792641268375.14.1926..87374981.56",
+        ".746...983629785419.1.4563779835146.12689437543576281981342.75.25..369.46495871.3",
+        ".8392465725986.134647135892.2845.7164.17.9.253..6124897345912.851624897389.3.6.41",
+        "7814..3695496317.86237985419.2.46875864.752.3.57289614.359..18719852.436476813.52",
+        "5182394767638.42954927.6.383279...618...2374994.5.182368549.3122341659871793.2654",
+        "7189.4.56423865.9..597..8.38.26495175943176821675.2.39.754.6128286153974941278365",
+        "3.9742658256..847..746952.19278.41.3168.2374..351769825924873.6641539827.83261594",
+        "15874..626273.15499.352.178785.32.9139147862546291583.8.419325651.2.4.8323685.914",
+        "67281495351869374.93..7518.1.54683278.6.32591.2.951.642815.76394673892.53591264.8",
+        "5.72.36492.98467533.459721843165.8278.5.721646.2481935948.25376153..8492.269345.1",
+        "9.8547.267.5392841342618957893...215254.8967367.25349.427831569.8692.734.39476.82",
+        ".94682.35.1.7439863685192.4541.67392.2.35146763.92.85.4562987139.21365481834.5629",
+        "9.6.485..481..76.357231684915743296869.5712.42436.97518691.4.7.324795186715863492",
+    };
+
+    // Hard for backtracking and for logic (Arto Inkala's, AI Escargot, Easter Monster and others)
+    const char* const hard9[] =
+    {
+        "8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..",
+        "..53.....8......2..7..1.5..4....53...1..7...6..32...8..6.5....9..4....3......97..",
+        "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+        "52...6.........7.13...........4..8..6......5...........418.........3..2...87.....",
+        "6.....8.3.4.7.................5.4.7.3..2.....1.6.......2.....5.....8.6......1....",
+        "48.3............71.2.......7.5....6....2..8.............1.76...3.....4......5....",
+        "....14....3....2...7..........9...3.6.1.............8.2.....1.4....5.6.....7.8...",
+        "......52..8.4......3...9...5.1...6..2..7........3.....6...1..........7.4.......3.",
+        "6.2.5.........3.4..........43...8....1....2........7..5..27...........81...6.....",
+        ".524.........7.1..............8.2...3.....6...9.5.....1.6.3...........897........",
+        "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+        "1.......2.9.4...5...6...7...5.9.3.......7.......85..4.7.....6...3...9.8...2.....1",
+    };
+
+    // 17 givens, the fewest a 9x9 puzzle with one solution can have
+    const char* const clue17_9[] =
+    {
+        ".......1.4.........2...........5.4.7..8...3....1.9....3..4..2...5.1........8.6...",
+        ".......1.4.........2...........5.6.4..8...3....1.9....3..4..2...5.1........8.7...",
+        ".......12....35......6...7.7.....3.....4..8..1...........12.....8.....4..5....6..",
+        ".......12..36..........7...41..2.......5..3..7.....6..28.....4....3..5...........",
+        ".......12..8.3...........4.12.5..........47...6.......5.7...3.....62.......1.....",
+        ".......12.5.4............3.7..6..4....1..........8....92....8.....51.7.......3...",
+        ".......123......6.....4....9.....5.......1.7..2..........35.4....14..8...6.......",
+        ".......124...9...........5..7.2.....6.....4.....1.8....18..........3.7..5.2......",
+        ".......125....8......7.....6..12....7.....45.....3.....3....8.....5..7...2.......",
+        ".......127...6...........5..8.2.....6.....4.....1.9....19..........3.8..5.2......",
+        ".......128...4...........6..9.2.....7.....4.....5.1....15..........3.9..6.2......",
+        ".......13....3..8..7..........2.6....3....9......1....6..5..2.4...4..7..1........",
+        ".......13...2............8....76.2....8...4...1.......2.....75.6..34.........8...",
+        ".......13...5...7....8.2......4..9..1.7............2..89.....5..4....6......1....",
+        ".......13...7...6....5.8......4..8..1.6............2..74.....5..2....4......1....",
+        ".......13.4.....8.2...6....6.9...4.....8........3......3.1..5......4.7.6.........",
+        "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9",
+    };
+
+    // 16x16 level 5: need search after logic
+    const char* const hard16[] =
+    {
+        "0,0,0,10,6,2,0,15,13,5,7,0,0,1,0,0,0,3,0,9,0,0,0,0,10,0,0,8,0,0,6,0,15,0,0,2,0,0,0,0,0,1,0,11,0,0,13,0,0,0,14,7,0,9,11,1,0,15,2,0,0,4,0,0,0,0,0,0,0,0,14,5,8,0,0,4,2,0,0,0,10,4,0,0,0,6,0,0,0,7,0,5,3,9,0,0,7,0,0,13,0,0,1,0,16,0,0,0,0,0,0,0,0,16,0,0,8,0,0,12,0,0,0,0,0,5,0,0,0,0,2,0,0,0,12,10,1,3,0,0,0,0,0,14,0,1,0,0,14,13,5,7,0,10,0,0,6,2,0,0,0,5,7,0,1,0,0,0,0,0,16,0,8,10,12,0,8,0,0,0,0,0,0,0,0,13,0,7,11,0,0,0,11,9,0,1,0,0,7,13,12,0,0,10,0,6,0,15,0,0,0,15,0,4,10,0,9,11,1,3,14,0,7,0,0,0,0,0,0,0,0,11,0,0,15,0,0,0,10,12,4,0,8,12,0,0,0,16,0,0,0,0,0,0,3,0",
+        "3,2,0,0,10,0,16,0,8,0,0,0,0,4,0,1,0,0,1,0,0,0,0,5,2,0,11,0,9,0,6,0,0,8,0,12,4,0,1,0,10,0,16,0,0,3,0,0,10,6,16,0,2,0,11,0,15,4,7,0,0,0,13,0,0,0,0,0,0,0,14,11,0,7,0,0,0,5,8,13,0,0,0,0,0,0,0,0,0,16,6,10,0,11,0,0,0,0,15,0,5,0,0,0,0,0,0,2,0,0,10,6,0,0,0,14,9,10,6,0,0,0,0,0,0,7,0,0,1,0,0,15,12,0,8,0,0,0,0,3,0,16,9,10,0,12,5,0,0,0,0,15,0,0,10,9,0,0,11,0,14,11,0,0,16,9,0,0,12,0,0,5,0,1,7,0,16,0,0,0,0,0,0,14,0,0,0,0,0,0,0,8,0,13,12,5,0,1,7,0,0,0,0,0,3,0,14,0,6,16,0,0,0,0,0,0,0,0,4,7,0,0,12,5,0,0,11,0,0,0,9,0,13,8,0,0,0,0,1,0,0,1,0,4,0,0,0,8,14,0,0,11,0,0,0,0",
+        "0,0,0,0,6,0,3,0,0,7,0,16,5,0,0,0,0,11,1,0,0,0,0,15,13,0,0,0,0,0,0,0,8,5,13,9,0,10,7,0,0,0,0,0,0,0,0,0,16,0,12,7,8,0,0,0,1,3,0,0,14,0,2,0,4,15,8,0,0,1,0,16,0,0,0,7,0,0,0,0,0,0,16,0,4,15,14,0,0,0,0,9,12,10,0,2,9,13,0,5,0,0,0,2,0,0,0,4,0,0,0,16,0,0,0,0,0,0,0,6,0,0,1,3,0,14,0,0,0,0,0,0,11,16,0,7,0,12,0,0,0,0,5,0,0,0,0,0,5,6,13,0,0,0,0,0,0,0,0,0,0,0,7,0,14,0,15,0,0,0,6,0,2,12,0,4,0,0,3,0,0,0,0,4,9,15,8,14,16,0,11,0,0,0,0,0,0,0,0,0,0,16,0,0,0,0,0,5,1,0,10,16,0,9,0,5,11,0,3,13,0,2,12,0,13,3,11,6,0,4,2,0,0,8,9,15,0,16,0,0,0,0,0,0,1,7,0,0,14,0,4,0,0,0,0,0",
+        "0,0,0,0,0,0,4,0,0,0,0,6,15,0,5,10,0,0,0,0,12,1,11,0,0,0,0,0,0,8,0,16,13,4,0,0,0,0,0,0,0,0,0,0,0,1,0,0,12,0,1,0,0,8,0,16,0,15,5,0,0,7,13,14,2,0,10,0,0,0,12,0,0,0,0,3,9,0,8,0,0,12,6,15,8,16,0,0,0,5,2,0,0,0,7,3,0,0,0,0,0,0,5,0,16,0,0,11,0,0,0,0,8,9,0,11,0,14,0,0,0,0,1,0,0,10,0,0,15,0,0,2,0,0,0,1,13,10,4,0,0,0,0,0,0,0,0,0,0,13,10,0,0,0,0,1,6,5,0,0,0,0,0,7,0,0,0,2,9,0,3,0,0,12,0,0,0,16,12,0,3,9,14,0,0,0,0,2,0,0,4,0,10,0,4,0,0,0,0,0,3,0,0,9,0,11,16,12,0,1,0,0,16,0,0,12,4,0,0,13,7,3,0,0,0,8,0,0,0,0,7,0,15,1,6,5,0,4,0,0,14,0,0,9,10,0,2,0,0,8,0,12,0,15,0,0",
+        "2,0,10,0,3,0,0,0,0,0,0,0,0,0,8,13,0,0,13,0,0,1,0,0,0,12,0,10,0,0,0,15,9,0,0,0,0,14,0,0,0,6,0,0,0,0,12,10,16,0,15,0,0,0,0,0,0,8,0,13,0,0,0,0,0,13,0,14,0,4,11,0,12,0,10,7,3,0,0,0,3,0,6,0,7,10,0,2,8,0,0,5,4,9,0,11,0,0,1,9,0,0,5,0,0,0,3,0,0,0,0,0,0,0,0,2,0,3,0,15,0,9,4,0,0,13,0,0,0,0,0,5,0,0,0,1,0,0,0,0,0,16,0,0,0,0,0,0,5,13,8,0,0,0,0,6,10,2,7,0,0,0,0,6,12,0,0,0,13,0,14,8,0,0,0,4,10,2,12,0,0,0,0,0,4,1,0,0,0,0,5,0,6,3,0,15,0,0,7,10,0,0,0,0,0,0,9,0,0,8,0,0,9,0,0,0,7,0,0,2,0,3,15,0,7,0,0,0,15,6,0,3,0,4,11,9,0,8,0,0,0,11,0,4,13,0,14,0,16,3,0,0,0,0,10,0",
+        "0,5,0,6,0,0,9,7,0,0,0,0,14,2,11,0,0,0,0,0,0,0,0,0,5,0,13,6,0,12,1,15,14,8,2,0,10,0,0,0,0,0,0,4,13,0,0,0,0,0,0,0,0,6,0,16,0,2,0,11,3,0,0,0,4,13,5,0,0,0,3,0,10,0,6,12,1,0,0,0,0,0,0,0,0,0,0,0,0,9,0,7,4,5,16,0,11,3,9,0,0,2,0,0,0,0,0,0,0,15,0,0,0,10,0,0,0,0,13,0,0,8,1,0,0,0,7,0,9,0,4,13,8,3,0,11,0,0,0,0,0,1,0,12,0,0,0,0,0,0,0,0,7,4,0,13,0,0,0,16,0,0,0,0,9,0,0,0,0,0,15,0,8,11,3,0,15,12,0,0,5,10,0,6,2,0,0,0,0,0,0,0,12,1,0,0,0,0,6,10,0,0,2,0,7,0,5,4,0,4,13,0,0,0,0,3,0,10,0,15,12,0,8,0,0,0,10,0,0,5,0,0,1,14,0,0,0,0,0,0,0,11,0,0,12,0,1,0,0,0,7,0,16,0,15,0",
+        "0,0,0,0,7,15,0,8,0,4,14,10,0,0,11,0,0,4,13,0,0,0,0,9,0,5,0,0,6,0,0,12,0,0,0,3,0,0,0,13,16,0,12,2,0,15,5,7,7,0,8,0,0,0,0,6,0,0,0,0,4,0,0,0,0,0,5,0,16,6,0,2,11,0,0,0,0,0,0,13,12,2,0,0,0,0,0,0,0,10,0,0,0,9,0,0,14,10,0,0,0,0,3,0,5,0,0,15,2,6,12,0,3,0,0,1,14,13,10,0,6,0,16,0,0,0,7,0,0,0,0,7,2,0,0,0,1,0,3,11,0,14,4,0,6,0,0,0,5,0,8,0,0,13,0,4,1,0,0,0,0,0,14,0,11,0,0,0,0,0,7,0,0,0,0,0,0,1,0,11,0,10,0,0,0,0,0,0,0,7,8,5,1,0,0,0,0,4,0,0,0,12,0,16,0,5,0,0,0,0,0,0,9,0,1,3,0,0,0,8,0,2,0,6,16,12,0,6,0,0,15,0,10,0,4,0,3,0,1,0,0,0,0,5,0,0,16,0,0,0,11,9,0,0,13,0",
+        "0,4,0,0,0,9,0,0,15,2,0,10,0,6,0,0,0,2,0,12,16,4,14,0,0,0,13,0,0,7,0,0,8,0,0,13,0,0,12,10,0,9,0,0,0,0,0,0,0,0,7,0,0,0,13,6,16,0,0,0,15,0,0,0,0,0,0,9,6,0,0,15,0,0,0,5,10,0,2,0,3,0,5,0,0,0,9,8,0,0,0,0,0,0,11,12,10,0,16,0,0,1,4,0,0,12,0,0,0,0,0,13,0,0,15,0,0,14,0,0,7,0,0,8,0,5,4,0,14,0,0,0,0,8,0,9,12,0,0,0,0,0,0,15,0,0,0,0,13,0,0,0,14,5,0,4,12,2,10,16,0,0,11,6,0,0,10,0,0,0,7,0,14,0,3,0,0,16,0,0,0,5,0,4,13,0,6,0,0,0,7,0,2,0,14,0,4,0,0,0,0,10,0,0,0,13,8,6,9,0,0,8,0,10,15,12,0,0,0,0,2,14,0,0,0,0,0,0,0,0,0,14,9,6,0,13,4,0,5,0,4,0,0,0,0,0,0,0,0,3,16,0,0,12,0,10",
+        "0,0,0,0,15,0,14,0,0,0,3,0,0,1,0,0,0,0,13,11,0,0,12,0,0,0,1,10,0,6,0,8,0,0,3,7,0,0,16,0,0,0,4,0,15,0,13,0,16,0,0,2,5,0,0,0,0,0,13,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,14,13,7,0,0,3,0,12,0,0,10,1,0,0,0,0,6,0,0,0,0,0,11,15,0,0,0,0,0,0,2,10,0,1,0,0,0,0,5,0,0,0,0,13,0,0,0,0,0,3,0,0,0,10,0,0,2,16,6,0,4,0,0,0,0,0,0,3,0,12,0,0,0,6,14,0,0,0,0,9,7,12,1,0,2,0,0,0,7,0,16,0,0,10,0,0,0,5,0,13,11,0,14,0,11,15,0,0,9,3,0,0,0,0,0,4,8,0,8,5,0,0,0,0,0,0,0,0,12,9,10,0,0,0,0,0,0,14,9,0,0,7,0,1,0,0,0,8,5,0,0,0,12,0,0,0,0,2,0,4,0,6,0,11,0,14,10,0,0,0,4,0,8,5,0,13,0,14,3,0,12,9",
+        "9,0,4,0,0,0,0,0,6,0,0,0,15,1,0,10,3,6,0,0,0,0,1,0,0,0,12,0,16,0,14,11,13,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,11,8,3,0,2,1,15,0,0,0,7,0,0,0,16,0,0,0,0,2,1,0,0,0,0,0,4,11,9,10,2,1,0,0,12,0,0,0,0,0,11,0,16,0,0,12,0,0,0,0,0,4,5,0,6,14,0,0,0,0,0,0,0,0,9,0,8,16,0,0,1,0,10,7,0,0,13,0,0,0,0,0,6,0,3,0,13,2,0,0,12,0,0,6,0,0,0,2,0,10,13,0,9,0,0,0,0,5,0,7,0,0,15,0,0,0,0,8,3,0,0,0,10,0,0,1,0,13,0,0,7,12,0,11,0,4,0,0,0,6,16,0,0,0,0,0,0,0,0,14,0,5,16,0,0,2,6,0,0,8,5,0,0,0,10,0,12,0,0,0,9,4,0,4,0,11,7,0,0,14,8,0,10,0,0,0,13,0,1,0,0,0,0,0,0,0,12,9,0,0,0,0,0,16,0",
+    };
+
+    // 25x25 with clues_for_level(4, 25) givens
+    const char* const grid25[] =
+    {
+        "14,21,17,0,10,8,12,0,0,0,0,2,0,0,11,20,0,0,9,0,0,6,0,0,16,9,0,25,0,20,0,0,13,4,0,0,10,17,23,14,0,7,16,0,6,0,0,0,8,5,8,0,15,22,0,0,20,0,25,18,0,1,0,0,0,2,0,0,11,0,17,0,0,14,21,0,13,0,0,2,24,0,0,7,6,5,12,15,22,0,0,0,21,0,0,0,18,20,0,0,24,0,0,6,0,0,0,0,0,23,3,0,0,18,9,12,0,0,8,0,0,0,0,11,0,4,19,1,0,13,7,0,0,10,14,0,0,0,9,15,21,0,0,0,0,0,0,0,25,0,0,23,12,8,21,0,0,0,0,0,0,0,1,0,0,3,2,18,25,0,10,0,0,0,6,15,0,20,0,5,0,0,18,0,11,0,0,0,14,7,13,0,19,0,0,0,0,0,0,0,0,6,0,14,0,17,0,23,12,0,0,0,2,0,0,5,20,0,0,0,1,24,13,0,0,25,18,0,0,0,0,0,19,0,24,0,21,12,8,0,0,0,0,0,14,0,9,0,0,22,5,15,22,0,0,0,0,25,0,0,0,24,0,0,16,11,19,4,0,0,0,0,14,0,17,3,0,18,2,9,13,0,0,19,1,17,0,0,12,0,24,6,7,0,10,22,20,0,0,0,21,0,23,0,0,5,0,0,0,20,4,0,0,0,13,9,18,0,3,0,0,10,24,16,7,13,0,19,1,0,16,0,0,0,0,0,0,0,20,0,0,23,0,21,0,0,0,0,3,25,0,0,0,0,24,0,0,17,23,12,25,9,0,2,0,8,0,0,5,0,19,1,0,0,4,0,0,11,0,0,0,0,1,0,16,0,17,8,0,23,0,0,10,0,0,0,3,15,0,0,0,0,9,0,0,18,25,0,0,0,0,7,14,21,0,0,0,0,19,16,0,0,17,0,0,0,0,0,0,7,0,17,12,0,0,2,0,11,13,0,15,0,20,22,0,0,0,0,19,0,0,12,0,0,17,22,0,0,9,0,1,0,24,16,0,0,11,2,18,13,14,21,7,0,0,19,0,0,16,4,0,0,10,14,21,20,0,0,3,22,0,0,0,23,5,0,13,25,18,2,10,0,0,17,6,12,0,8,5,0,0,0,13,4,0,22,0,9,0,25,16,0,0,0,24,20,9,3,0,0,0,18,0,13,4,14,0,0,17,10,19,16,24,0,0,0,0,23,0,0,1,0,16,7,0,0,6,0,0,0,0,0,3,25,0,0,5,0,0,0,0,4,18,2,11,0,11,0,0,0,0,19,0,0,7,0,23,0,0,12,0,21,14,10,0,3,0,0,20,0,0,0,5,0,0,0,0,0,3,25,0,0,0,0,0,0,0,0,2,4,0,0,6,0,0",
+        "23,0,8,0,0,20,22,0,12,0,0,0,0,0,0,2,0,0,3,0,0,0,13,0,9,21,24,18,14,0,0,16,0,0,0,22,5,0,1,0,10,13,19,4,0,8,0,25,11,15,0,0,17,0,0,8,0,0,11,25,9,0,19,10,0,0,0,0,24,6,0,1,5,0,22,0,4,19,13,0,18,0,21,0,14,15,0,0,23,0,0,5,20,0,0,0,2,0,3,16,1,0,0,5,0,0,9,0,0,0,0,7,0,0,3,23,0,0,0,15,0,21,0,24,0,12,22,7,1,0,0,0,0,0,0,17,2,13,3,16,11,0,14,0,0,0,0,0,6,0,11,0,14,23,0,7,0,12,22,0,0,0,5,0,0,3,0,0,16,17,25,4,0,0,19,0,0,0,0,0,0,18,0,6,21,8,0,14,11,0,0,1,0,22,20,0,3,0,16,0,0,0,5,0,0,0,17,0,16,2,20,0,7,0,22,4,0,25,0,19,0,0,0,0,0,3,0,13,2,17,14,0,0,0,0,0,10,0,0,9,0,21,0,0,18,0,12,1,22,20,0,1,0,0,12,0,0,13,10,0,3,20,0,0,0,25,19,15,0,11,6,0,0,0,0,0,0,0,0,11,22,12,5,1,0,0,8,0,0,0,7,20,0,0,3,9,13,0,10,4,13,10,0,0,0,6,0,0,0,8,11,0,0,0,0,0,0,0,1,12,0,0,20,0,0,7,2,16,20,0,0,0,25,0,19,4,0,9,0,10,0,0,6,21,0,0,5,0,0,0,14,0,0,0,0,16,0,0,0,0,0,0,22,5,0,0,17,0,0,0,0,25,19,23,0,6,0,0,0,5,10,13,0,17,0,7,12,2,0,20,9,4,0,19,25,0,15,0,8,14,0,20,0,0,0,23,0,0,19,0,0,0,10,16,0,0,11,21,8,0,1,0,0,18,5,0,19,23,0,25,0,0,6,0,24,14,0,0,0,0,22,0,0,0,7,0,0,0,17,0,0,0,21,11,0,2,0,22,0,0,5,0,0,0,0,0,0,10,0,0,0,0,4,0,0,0,0,0,3,0,21,14,0,8,11,25,4,0,0,19,6,24,0,0,0,0,0,0,0,0,19,0,0,0,0,0,0,18,0,0,0,0,24,8,14,0,22,3,7,0,0,0,16,13,0,0,0,0,0,0,4,10,0,0,16,2,22,0,20,0,0,0,11,0,0,0,0,15,14,21,0,14,0,0,0,0,2,20,7,0,1,6,12,18,0,17,0,0,13,10,11,19,0,25,23,20,0,3,22,2,0,23,19,0,9,0,0,4,0,13,8,0,0,0,0,0,0,6,0,1,0,0,4,0,10,24,21,0,0,15,0,9,11,0,0,18,0,0,5,0,0,0,22,0,2",
+        "19,0,0,22,0,18,0,0,0,14,24,25,0,8,11,0,0,9,0,0,0,16,0,0,5,0,11,24,0,0,6,0,7,19,0,0,0,13,0,4,0,2,0,0,0,17,0,0,0,0,0,0,9,0,0,0,0,0,0,0,16,0,2,0,5,14,17,0,10,0,22,0,12,0,0,0,18,1,0,0,5,2,16,20,3,0,0,0,0,0,0,21,24,25,0,0,0,23,15,0,0,5,0,0,0,4,13,0,15,23,1,0,17,14,18,12,0,7,19,6,0,24,0,25,0,0,0,3,0,20,9,0,0,13,0,14,17,0,0,1,0,4,12,0,7,0,0,0,0,24,0,9,0,18,0,0,5,0,0,25,3,0,0,0,0,0,11,14,0,1,4,0,0,22,0,0,0,14,0,10,16,0,0,0,0,0,0,0,0,0,0,5,0,21,24,18,23,15,13,0,0,7,0,4,19,0,11,0,0,10,0,21,5,0,0,15,18,0,0,0,6,3,20,0,16,21,0,0,5,0,7,4,0,0,0,0,0,0,15,9,20,0,3,2,0,0,14,10,17,0,0,23,0,1,0,0,16,25,5,0,20,0,7,2,3,0,0,0,0,14,9,19,22,0,0,0,0,25,0,21,0,0,0,0,22,0,0,1,0,23,2,0,20,6,3,0,10,0,11,0,4,0,19,9,0,0,0,10,0,0,25,0,16,0,0,0,0,15,18,23,0,0,0,6,0,11,0,10,24,17,0,7,20,0,0,0,4,0,0,0,21,0,25,0,0,1,0,0,0,0,6,0,0,0,2,0,1,15,18,13,0,0,0,0,0,22,0,19,0,0,0,25,21,5,8,0,0,0,0,0,0,0,0,0,18,0,24,0,0,10,0,23,0,9,0,3,0,0,0,25,0,15,0,14,18,0,0,21,16,0,2,0,0,6,20,11,8,17,0,10,23,22,0,9,0,0,0,22,0,4,0,0,0,0,0,0,0,3,5,25,18,0,13,1,15,12,0,0,0,20,0,0,0,8,0,0,0,2,0,6,22,0,23,0,19,5,3,0,0,0,14,13,18,0,0,16,0,21,0,5,0,0,22,9,4,0,0,14,0,0,0,0,2,0,20,8,17,0,24,10,0,2,6,0,7,13,0,0,14,1,11,0,0,0,17,9,15,4,0,22,20,0,0,3,0,0,13,18,10,0,0,0,5,3,0,0,12,0,7,0,0,0,11,8,0,0,4,0,0,0,23,0,0,0,9,17,0,0,0,0,0,3,0,16,21,1,10,0,14,0,19,6,0,12,2,8,0,11,25,0,0,0,6,0,0,0,0,0,9,22,16,20,0,3,0,0,0,0,0,0,0,21,0,20,16,0,0,0,0,0,0,14,10,1,0,0,19,0,0,2,0,0,24,0,17",
+        "0,0,0,0,21,0,19,0,12,0,15,11,7,0,18,0,6,25,0,0,0,0,0,9,0,0,20,0,0,0,23,0,0,0,0,0,0,8,2,0,18,0,0,7,0,6,0,0,0,0,0,0,0,0,25,16,0,11,18,15,22,0,0,23,0,12,3,4,19,0,0,0,0,13,21,0,0,0,18,15,2,8,1,0,0,0,0,10,6,0,9,0,22,24,17,0,19,20,12,4,0,17,0,0,22,0,10,0,5,25,0,0,0,3,0,0,2,0,0,1,16,0,11,0,0,0,19,0,4,1,9,23,0,0,0,0,8,0,0,0,0,0,0,0,7,5,6,0,25,17,0,0,5,0,0,18,0,0,15,0,20,24,0,0,0,0,12,1,3,0,0,0,0,21,0,0,24,0,22,0,0,0,10,25,0,1,0,0,0,4,0,13,11,0,0,18,16,7,15,0,0,7,0,0,14,0,2,0,21,11,0,0,0,0,25,0,0,0,23,0,12,0,19,0,0,2,0,13,0,11,12,3,0,0,1,14,0,0,0,0,0,0,17,6,0,0,23,0,22,0,12,3,0,1,0,0,0,23,0,19,0,0,0,21,11,0,15,10,0,16,0,5,0,17,24,0,23,0,20,19,0,0,6,17,24,8,3,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,17,0,0,18,16,0,0,0,0,9,0,20,1,0,8,12,3,21,13,2,0,0,18,16,0,14,0,21,0,0,0,7,0,0,0,25,0,20,22,0,9,0,4,0,0,1,8,0,0,0,0,7,4,12,0,0,0,10,16,18,0,0,17,0,24,5,0,22,9,0,0,0,15,0,14,10,0,11,0,13,7,16,0,0,0,0,24,19,0,0,22,0,0,0,0,8,2,0,0,20,19,0,0,0,0,24,23,2,0,0,0,0,7,0,16,0,13,0,0,0,0,6,21,13,0,7,0,1,0,0,0,2,0,0,0,14,0,0,0,23,0,5,20,0,0,0,3,0,12,0,0,0,20,22,0,0,3,0,0,0,11,0,0,14,0,15,18,0,25,5,24,0,25,0,0,0,23,0,15,18,0,6,0,9,0,0,19,8,1,2,4,12,11,0,0,7,16,0,0,0,23,9,10,0,0,6,5,0,0,20,0,3,0,0,0,0,0,7,0,21,16,18,0,4,8,2,0,19,0,22,3,0,18,0,0,0,16,6,10,0,14,0,0,17,25,23,9,0,0,7,16,18,8,0,4,0,0,0,0,14,10,6,0,24,9,0,25,19,0,22,3,12,0,15,0,0,5,0,11,0,0,0,0,25,0,0,23,0,0,0,20,0,8,1,0,0,0,20,0,0,0,0,0,0,25,0,9,13,4,0,0,2,0,7,0,11,0,10,0,15,0,5",
+    };
+}
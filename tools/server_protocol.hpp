@@ -0,0 +1,275 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// The line-delimited JSON of sudoku-server and sudoku-load: every message is
+// one flat JSON object on one line. Nested objects and arrays are accepted
+// but only kept as raw text, neither side needs to look inside them.
+namespace protocol
+{
+    struct Field
+    {
+        std::string key;
+        std::string value; // Unescaped text of a string, the token of anything else
+        std::string raw; // The value as it appeared in the message
+        bool quoted = false; // value came from a JSON string
+
+        bool is_number() const { return !quoted && !value.empty() && (value[0] == '-' || (value[0] >= '0' && value[0] <= '9')); }
+    };
+
+    // A JSON number, true, false or null
+    inline bool is_scalar(const std::string& token)
+    {
+        if (token == "true" || token == "false" || token == "null") return true;
+        std::size_t i = 0;
+        auto digits = [&]
+        {
+            std::size_t start = i;
+            while (i < token.size() && token[i] >= '0' && token[i] <= '9') ++i;
+            return i > start;
+        };
+        if (i < token.size() && token[i] == '-') ++i;
+        if (i < token.size() && token[i] == '0') ++i;
+        else if (!digits()) return false;
+        if (i < token.size() && token[i] == '.' && (++i, !digits())) return false;
+        if (i < token.size() && (token[i] == 'e' || token[i] == 'E'))
+        {
+            ++i;
+            if (i < token.size() && (token[i] == '+' || token[i] == '-')) ++i;
+            if (!digits()) return false;
+        }
+        return i == token.size();
+    }
+
+    // Quotes and escapes text as a JSON string
+    inline std::string quote(const std::string& text)
+    {
+        std::string out = "\"";
+        for (char c : text)
+        {
+            switch (c)
+            {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20)
+                {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", (unsigned char)c);
+                    out += escape;
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+        return out + '"';
+    }
+
+    // A received message, parsed into its top level fields
+    class Message
+    {
+    public:
+        // False when line is not one JSON object
+        bool parse(const std::string& line)
+        {
+            text = &line;
+            pos = 0;
+            fields.clear();
+            skip_space();
+            if (!take('{')) return false;
+            skip_space();
+            if (!take('}'))
+            {
+                do
+                {
+                    Field field;
+                    skip_space();
+                    if (!read_string(field.key)) return false;
+                    skip_space();
+                    if (!take(':')) return false;
+                    skip_space();
+                    if (!read_value(field)) return false;
+                    fields.push_back(std::move(field));
+                    skip_space();
+                } while (take(','));
+                if (!take('}')) return false;
+            }
+            skip_space();
+            return pos == line.size();
+        }
+
+        const Field* find(const std::string& key) const
+        {
+            for (const Field& field : fields)
+            {
+                if (field.key == key) return &field;
+            }
+            return nullptr;
+        }
+
+        std::string text_of(const std::string& key, const std::string& fallback = "") const
+        {
+            const Field* field = find(key);
+            return field && field->quoted ? field->value : fallback;
+        }
+
+        long long number(const std::string& key, long long fallback = 0) const
+        {
+            const Field* field = find(key);
+            if (!field || field->quoted) return fallback;
+            char* end = nullptr;
+            long long value = std::strtoll(field->value.c_str(), &end, 10);
+            return *end == '\0' ? value : fallback;
+        }
+
+        bool flag(const std::string& key) const
+        {
+            const Field* field = find(key);
+            return field && !field->quoted && field->value == "true";
+        }
+
+    private:
+        std::vector<Field> fields;
+        const std::string* text = nullptr;
+        std::size_t pos = 0;
+
+        void skip_space()
+        {
+            while (pos < text->size() && ((*text)[pos] == ' ' || (*text)[pos] == '\t' || (*text)[pos] == '\r')) ++pos;
+        }
+
+        bool take(char c)
+        {
+            if (pos < text->size() && (*text)[pos] == c)
+            {
+                ++pos;
+                return true;
+            }
+            return false;
+        }
+
+        // A JSON string at pos, unescaped into out. \u escapes outside ASCII become '?'
+        bool read_string(std::string& out)
+        {
+            if (!take('"')) return false;
+            out.clear();
+            while (pos < text->size())
+            {
+                char c = (*text)[pos++];
+                if (c == '"') return true;
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+                if (pos >= text->size()) return false;
+                char e = (*text)[pos++];
+                switch (e)
+                {
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u':
+                {
+                    if (pos + 4 > text->size()) return false;
+                    char* end = nullptr;
+                    std::string hex = text->substr(pos, 4);
+                    long code = std::strtol(hex.c_str(), &end, 16);
+                    if (*end != '\0') return false;
+                    out += code < 0x80 ? (char)code : '?';
+                    pos += 4;
+                    break;
+                }
+                default: out += e; // \" \\ and \/
+                }
+            }
+            return false;
+        }
+
+        bool read_value(Field& field)
+        {
+            std::size_t start = pos;
+            if (pos < text->size() && (*text)[pos] == '"')
+            {
+                if (!read_string(field.value)) return false;
+                field.quoted = true;
+            }
+            else if (pos < text->size() && ((*text)[pos] == '{' || (*text)[pos] == '['))
+            {
+                if (!skip_nested()) return false;
+                field.value = text->substr(start, pos - start);
+            }
+            else
+            {
+                while (pos < text->size() && (*text)[pos] != ',' && (*text)[pos] != '}' &&
+                       (*text)[pos] != ' ' && (*text)[pos] != '\t' && (*text)[pos] != '\r') ++pos;
+                field.value = text->substr(start, pos - start);
+                if (!is_scalar(field.value)) return false;
+            }
+            field.raw = text->substr(start, pos - start);
+            return true;
+        }
+
+        // Steps over a nested object or array, strings inside included
+        bool skip_nested()
+        {
+            int level = 0;
+            while (pos < text->size())
+            {
+                char c = (*text)[pos];
+                if (c == '"')
+                {
+                    std::string ignored;
+                    if (!read_string(ignored)) return false;
+                    continue;
+                }
+                ++pos;
+                if (c == '{' || c == '[') ++level;
+                else if ((c == '}' || c == ']') && --level == 0) return true;
+            }
+            return false;
+        }
+    };
+
+    // An object to send, written field by field
+    class Object
+    {
+    public:
+        void raw(const std::string& key, const std::string& json) { prefix(key); out += json; }
+        void add(const std::string& key, const std::string& value) { raw(key, quote(value)); }
+        void add(const std::string& key, const char* value) { raw(key, quote(value)); }
+        void add(const std::string& key, bool value) { raw(key, value ? "true" : "false"); }
+        void add(const std::string& key, int value) { raw(key, std::to_string(value)); }
+        void add(const std::string& key, long long value) { raw(key, std::to_string(value)); }
+        void add(const std::string& key, double value)
+        {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.10g", value);
+            raw(key, text);
+        }
+        void append(const Object& other) // The fields of other after these
+        {
+            if (!out.empty() && !other.out.empty()) out += ", ";
+            out += other.out;
+        }
+        std::string str() const { return "{" + out + "}"; }
+
+    private:
+        std::string out;
+
+        void prefix(const std::string& key)
+        {
+            if (!out.empty()) out += ", ";
+            out += quote(key) + ": ";
+        }
+    };
+}
@@ -0,0 +1,175 @@
+// Puzzle bank builder: generates puzzles on all cores and packs them into a
+// bank file that PuzzleBank maps (see include/puzzle_bank.hpp).
+//
+//   sudoku-bank [-j threads] [-n count] [-s sizes] [-l levels] [-r seed] output
+//
+// sizes and levels are comma separated lists, 9 and 1,2,3,4,5 by default, with
+// count puzzles (100 by default) for every pair. Levels are rated by technique
+// up to MAX_RATING_SIZE and by clue count above it. With -r the bank is the
+// same on every run whatever the thread count.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "generator.hpp"
+#include "puzzle_bank.hpp"
+#include "thread_pool.hpp"
+
+namespace
+{
+    constexpr int chunk_size = 8; // Puzzles per pool task
+
+    bool parse_list(const char* text, std::vector<int>& values)
+    {
+        values.clear();
+        std::stringstream in(text);
+        std::string item;
+        while (std::getline(in, item, ','))
+        {
+            char* end = nullptr;
+            long value = std::strtol(item.c_str(), &end, 10);
+            if (item.empty() || *end != '\0') return false;
+            values.push_back((int)value);
+        }
+        return !values.empty();
+    }
+
+    int usage()
+    {
+        std::cerr << "usage: sudoku-bank [-j threads] [-n count] [-s sizes] [-l levels] [-r seed] output\n";
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int threads = 0;
+    int count = 100;
+    std::vector<int> sizes = { 9 };
+    std::vector<int> levels = { 1, 2, 3, 4, 5 };
+    std::uint64_t seed = std::random_device{}();
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            count = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            if (!parse_list(argv[++i], sizes)) return usage();
+        }
+        else if (std::strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+        {
+            if (!parse_list(argv[++i], levels)) return usage();
+        }
+        else if (std::strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+        {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
+        {
+            usage();
+            return 0;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    if (!path || count <= 0) return usage();
+    for (int size : sizes)
+    {
+        if (!solver::subgrid_size_of(size))
+        {
+            std::cerr << "sudoku-bank: invalid size " << size << "\n";
+            return 1;
+        }
+    }
+    for (int level : levels)
+    {
+        if (level < 1 || level > 5)
+        {
+            std::cerr << "sudoku-bank: invalid level " << level << "\n";
+            return 1;
+        }
+    }
+
+    // One slot per puzzle, filled in place so the bank order does not depend on scheduling
+    std::vector<generator::Puzzle> puzzles(sizes.size() * levels.size() * count);
+
+    std::atomic<int> short_count{0}; // Puzzles left with more clues than their level asks
+    auto start = std::chrono::steady_clock::now();
+    {
+        parallel::WorkStealingPool pool(threads);
+        parallel::TaskGroup group(pool);
+        for (std::size_t s = 0; s < sizes.size(); ++s)
+        {
+            for (std::size_t l = 0; l < levels.size(); ++l)
+            {
+                std::size_t base = (s * levels.size() + l) * count;
+                for (int first = 0; first < count; first += chunk_size)
+                {
+                    group.run([&, s, l, base, first]
+                    {
+                        int size = sizes[s];
+                        int level = levels[l];
+                        // Seeded by position in the bank, not by the thread that runs it
+                        generator::SudokuGenerator generator(size, generator::default_fill_mode(size), seed + base + first);
+                        int last = std::min(count, first + chunk_size);
+                        for (int i = first; i < last; ++i)
+                        {
+                            generator::Puzzle& puzzle = puzzles[base + i];
+                            if (size <= MAX_RATING_SIZE)
+                            {
+                                puzzle.puzzle = generator.generate_rated(level, puzzle.solution, &puzzle.rating);
+                            }
+                            else
+                            {
+                                // Capped checks, uncapped ones take hours on these boards
+                                if (!generator.generate_puzzle(generator::clues_for_level(level, size), puzzle.puzzle, puzzle.solution, 4LL * size))
+                                {
+                                    short_count.fetch_add(1, std::memory_order_relaxed);
+                                }
+                            }
+                        }
+                    });
+                }
+            }
+        }
+        group.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    generator::PuzzleBankWriter writer;
+    for (std::size_t i = 0; i < puzzles.size(); ++i)
+    {
+        writer.add(levels[i / count % levels.size()], puzzles[i]);
+    }
+    if (!writer.write(path))
+    {
+        std::cerr << "sudoku-bank: cannot write " << path << "\n";
+        return 1;
+    }
+
+    std::fprintf(stderr, "puzzles: %zu  wall: %.3f s  throughput: %.1f puzzles/s\n",
+                 writer.size(), seconds, seconds > 0 ? writer.size() / seconds : 0.0);
+    if (short_count.load())
+    {
+        std::fprintf(stderr, "%d puzzles kept more clues than their level asks\n", short_count.load());
+    }
+    return 0;
+}
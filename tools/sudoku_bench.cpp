@@ -0,0 +1,348 @@
+// Benchmark suite: times the solver engines on the corpora of bench_corpus.hpp,
+// the generator and the game's solved check, and prints the results as JSON.
+//
+//   sudoku-bench [-t milliseconds] [-l label]
+//
+// Every measurement repeats until it has run for at least -t milliseconds
+// (200 by default) and reports throughput, nodes per second and p50/p99
+// latency. -l puts a label (say the commit) into the output, so runs can be
+// compared across commits. The JSON goes to stdout, progress to stderr.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "bench_corpus.hpp"
+#include "bitplane9.hpp"
+#include "dlx.hpp"
+#include "game_state.hpp"
+#include "generator.hpp"
+#include "puzzle_io.hpp"
+#include "search.hpp"
+#include "solve.hpp"
+#include "timing.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Lut
+    {
+        solver::SubgridLut table;
+    };
+
+    struct Corpus
+    {
+        const char* name;
+        std::vector<solver::Board> puzzles;
+    };
+
+    // Timings of one measurement, every repetition of every item
+    struct Samples
+    {
+        std::vector<double> latency_us;
+        long long nodes = 0;
+        double seconds = 0;
+        int errors = 0;
+    };
+
+    template <std::size_t N>
+    Corpus load_corpus(const char* name, const char* const (&lines)[N])
+    {
+        Corpus corpus{name, {}};
+        for (const char* line : lines)
+        {
+            solver::Board board;
+            if (!solver::parse_puzzle(line, board))
+            {
+                std::cerr << "sudoku-bench: malformed puzzle in " << name << "\n";
+                std::exit(1);
+            }
+            corpus.puzzles.push_back(std::move(board));
+        }
+        return corpus;
+    }
+
+    // Two puzzles for every size from 36x36 to 100x100: a solved grid of a
+    // fixed seed with the share blanks of its cells emptied at random. No hand
+    // picked corpus exists at these sizes, this one still shows which engine
+    // wins at each mask width.
+    Corpus blanked_corpus(const char* name, double blanks)
+    {
+        Corpus corpus{name, {}};
+        generator::Xoshiro256 rng(1);
+        for (int n = 36; n <= MAX_BOARD_SIZE; n += 2 * (int)std::sqrt(n) + 1) // The next square
+        {
+            for (int k = 0; k < 2; ++k)
+            {
+                generator::SudokuGenerator generator(n, generator::default_fill_mode(n), 1000 + k);
+                solver::Board board = generator.generate_solved();
+                for (int cell = 0; cell < n * n; ++cell)
+                {
+                    if (rng.below(1000) < blanks * 1000) board.data()[cell] = 0;
+                }
+                corpus.puzzles.push_back(std::move(board));
+            }
+        }
+        return corpus;
+    }
+
+    // A solution of puzzle: its givens kept and every unit a permutation
+    bool is_solution_of(const solver::Board& puzzle, const solver::Board& board)
+    {
+        int n = (int)board.size();
+        int subgrid_size = solver::subgrid_size_of(n);
+        std::vector<int> seen(3 * n * (n + 1), 0);
+        for (int row = 0; row < n; ++row)
+        {
+            for (int col = 0; col < n; ++col)
+            {
+                int num = board[row][col];
+                if (num < 1 || num > n || (puzzle[row][col] && puzzle[row][col] != num)) return false;
+                int box = (row / subgrid_size) * subgrid_size + col / subgrid_size;
+                if (seen[row * (n + 1) + num]++ || seen[(n + col) * (n + 1) + num]++ || seen[(2 * n + box) * (n + 1) + num]++) return false;
+            }
+        }
+        return true;
+    }
+
+    // Runs step(item, samples) over all items until min_ms have passed, at least once
+    template <typename Step>
+    Samples measure(int items, double min_ms, Step step)
+    {
+        Samples samples;
+        auto start = Clock::now();
+        do
+        {
+            for (int i = 0; i < items; ++i)
+            {
+                auto begin = Clock::now();
+                step(i, samples);
+                samples.latency_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - begin).count());
+            }
+            samples.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (samples.seconds * 1000 < min_ms);
+        return samples;
+    }
+
+    // Minimal JSON writer: objects are written field by field, commas tracked per level
+    class Json
+    {
+    public:
+        void open(const char* key, char bracket) { prefix(key); out += bracket; first = true; }
+        void close(char bracket) { out += bracket; first = false; }
+        void field(const char* key, const std::string& value) { prefix(key); out += '"' + value + '"'; }
+        void field(const char* key, double value)
+        {
+            char text[32];
+            std::snprintf(text, sizeof(text), "%.10g", value);
+            prefix(key);
+            out += text;
+        }
+        const std::string& str() const { return out; }
+
+    private:
+        std::string out;
+        bool first = true;
+
+        void prefix(const char* key)
+        {
+            if (!first) out += ", ";
+            first = false;
+            if (key) out += std::string("\"") + key + "\": ";
+        }
+    };
+
+    void write_samples(Json& json, const Samples& samples)
+    {
+        double runs = (double)samples.latency_us.size();
+        json.field("runs", runs);
+        json.field("errors", samples.errors);
+        json.field("per_sec", samples.seconds > 0 ? runs / samples.seconds : 0.0);
+        json.field("nodes_per_sec", samples.seconds > 0 ? samples.nodes / samples.seconds : 0.0);
+        json.field("p50_us", timing::percentile(samples.latency_us, 50));
+        json.field("p99_us", timing::percentile(samples.latency_us, 99));
+    }
+
+    int usage()
+    {
+        std::cerr << "usage: sudoku-bench [-t milliseconds] [-l label]\n";
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    double min_ms = 200;
+    std::string label;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            min_ms = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+        {
+            label = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
+        {
+            usage();
+            return 0;
+        }
+        else
+        {
+            return usage();
+        }
+    }
+
+    std::vector<Corpus> corpora;
+    corpora.push_back(load_corpus("easy9", bench::easy9));
+    corpora.push_back(load_corpus("hard9", bench::hard9));
+    corpora.push_back(load_corpus("clue17_9", bench::clue17_9));
+    corpora.push_back(load_corpus("hard16", bench::hard16));
+    corpora.push_back(load_corpus("grid25", bench::grid25));
+    corpora.push_back(blanked_corpus("grid_big", 0.3));
+
+    std::vector<std::unique_ptr<Lut>> luts(MAX_BOARD_SIZE + 1);
+    for (int n = 1; n <= MAX_BOARD_SIZE; ++n)
+    {
+        int subgrid_size = solver::subgrid_size_of(n);
+        if (!subgrid_size) continue;
+        luts[n] = std::make_unique<Lut>();
+        solver::fill_subgrid_lut(luts[n]->table, n, subgrid_size);
+    }
+
+    Json json;
+    json.open(nullptr, '{');
+    json.field("label", label);
+    json.field("kernel", std::string(solver::bitplane9_isa()));
+    json.field("min_ms", min_ms);
+
+    // Engines: "solve" is solver::solve as the game calls it (the bitplane
+    // kernel for 9x9, propagation up to MAX_PROPAGATION_SIZE), the others
+    // force one engine on every size
+    const char* engines[] = { "solve", "propagation", "dlx" };
+    json.open("solve", '[');
+    for (const Corpus& corpus : corpora)
+    {
+        for (const char* engine : engines)
+        {
+            std::cerr << "solve " << corpus.name << " " << engine << "\n";
+            solver::Board board;
+            Samples samples = measure((int)corpus.puzzles.size(), min_ms, [&](int i, Samples& s)
+            {
+                const solver::Board& puzzle = corpus.puzzles[i];
+                int n = (int)puzzle.size();
+                int subgrid_size = solver::subgrid_size_of(n);
+                board = puzzle;
+                bool solved = false;
+                if (std::strcmp(engine, "solve") == 0)
+                {
+                    parallel::Progress progress; // Only to read the node count back
+                    solved = solver::solve(board, subgrid_size, luts[n]->table, nullptr, &progress) == solver::Result::Solved;
+                    s.nodes += progress.nodes.load(std::memory_order_relaxed);
+                }
+                else if (std::strcmp(engine, "propagation") == 0)
+                {
+                    bitmask::dispatch(n, [&](auto tag)
+                    {
+                        solver::Search<typename decltype(tag)::type> search(n, luts[n]->table);
+                        solved = search.load(board) && search.solve();
+                        if (solved) search.store(board);
+                        s.nodes += search.get_nodes();
+                    });
+                }
+                else
+                {
+                    solver::DancingLinks dlx(n, subgrid_size);
+                    solved = dlx.load(board) && dlx.solve(board);
+                    s.nodes += dlx.get_nodes();
+                }
+                if (!solved || !is_solution_of(puzzle, board)) ++s.errors;
+            });
+
+            json.open(nullptr, '{');
+            json.field("corpus", std::string(corpus.name));
+            json.field("engine", std::string(engine));
+            json.field("puzzles", (double)corpus.puzzles.size());
+            write_samples(json, samples);
+            json.close('}');
+        }
+    }
+    json.close(']');
+
+    // Seeded, so every run generates the same puzzles
+    json.open("generate", '[');
+    for (int n : { 9, 16 })
+    {
+        std::cerr << "generate " << n << "\n";
+        int clues = generator::clues_for_level(3, n);
+        generator::SudokuGenerator generator(n, generator::default_fill_mode(n), 1);
+        solver::Board puzzle, solution;
+        parallel::Progress progress; // Only to read the node count back
+        generator.set_progress(&progress);
+        Samples samples = measure(1, min_ms, [&](int, Samples& s)
+        {
+            bool reached = generator.generate_puzzle(clues, puzzle, solution);
+            s.nodes += progress.nodes.exchange(0, std::memory_order_relaxed);
+            if (!reached || !is_solution_of(puzzle, solution)) ++s.errors; // A missed clue count is an error here, level 3 is always reachable
+        });
+
+        json.open(nullptr, '{');
+        json.field("size", n);
+        json.field("clues", clues);
+        write_samples(json, samples);
+        json.close('}');
+    }
+    json.close(']');
+
+    // One edit and one check, the work Submit does after every typed number
+    json.open("is_solved", '[');
+    for (int n : { 9, 25, 100 })
+    {
+        std::cerr << "is_solved " << n << "\n";
+        solver::GameState game(n);
+        generator::SudokuGenerator generator(n, generator::default_fill_mode(n), 1);
+        solver::Board solution;
+        generator.generate_puzzle(n * n, solution); // Nothing removed: the puzzle is the solution
+        game.set_puzzle(solution, solution);
+        game.clear_from_puzzle();
+
+        constexpr int batch = 1024; // Checks per timed step, one check is too short to time alone
+        int cell = 0;
+        Samples samples = measure(1, min_ms, [&](int, Samples& s)
+        {
+            for (int i = 0; i < batch; ++i, cell = (cell + 1) % (n * n))
+            {
+                int row = cell / n, col = cell % n;
+                game.set_cell(row, col, 0);
+                if (game.is_solved()) ++s.errors;
+                game.set_cell(row, col, solution[row][col]);
+                if (!game.is_solved()) ++s.errors;
+            }
+        });
+
+        json.open(nullptr, '{');
+        json.field("size", n);
+        json.field("ns_per_check", timing::percentile(samples.latency_us, 50) * 1000 / (2 * batch));
+        json.field("errors", samples.errors);
+        json.close('}');
+    }
+    json.close(']');
+
+    struct rusage usage_info;
+    getrusage(RUSAGE_SELF, &usage_info);
+    json.field("peak_rss_kb", (double)usage_info.ru_maxrss); // Kilobytes on Linux
+    json.close('}');
+
+    std::cout << json.str() << "\n";
+    return 0;
+}
@@ -0,0 +1,268 @@
+// Load generator for sudoku-server: opens connections to its socket, keeps
+// a window of requests in flight on each and reports throughput and latency.
+//
+//   sudoku-load [-u socket_path] [-c connections] [-n requests] [-w window] [-o op] [file]
+//
+// Puzzles come from file, one per line, or from the hard 9x9 corpus of
+// bench_corpus.hpp. op is solve (the default), validate, rate or generate
+// (9x9, level 3). -n requests (1000 by default) are spread over -c
+// connections (4), each with up to -w unanswered requests (16). The summary
+// goes to stdout as one JSON line, like sudoku-bench.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "bench_corpus.hpp"
+#include "server_protocol.hpp"
+#include "timing.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // One connection's share of the requests, ids first .. first + count - 1
+    struct Share
+    {
+        int first = 0;
+        int count = 0;
+        int errors = 0;
+        bool failed = false; // The connection broke before every answer came back
+        std::vector<double> latency_us; // Answered requests only, in the order the answers came
+    };
+
+    bool write_all(int fd, const std::string& text)
+    {
+        std::size_t done = 0;
+        while (done < text.size())
+        {
+            ssize_t written = ::write(fd, text.data() + done, text.size() - done);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            done += (std::size_t)written;
+        }
+        return true;
+    }
+
+    int connect_to(const char* path)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (sockaddr*)&address, sizeof(address)) < 0)
+        {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    std::string request_line(int id, const std::string& op, const std::vector<std::string>& puzzles)
+    {
+        protocol::Object request;
+        request.add("id", id);
+        request.add("op", op);
+        if (op == "generate")
+        {
+            request.add("size", 9);
+            request.add("level", 3);
+        }
+        else
+        {
+            request.add("puzzle", puzzles[id % puzzles.size()]);
+        }
+        return request.str() + "\n";
+    }
+
+    // Runs share over fd, keeping the latency of every answer in share.latency_us
+    void run_share(int fd, Share& share, int window, const std::string& op, const std::vector<std::string>& puzzles)
+    {
+        std::vector<Clock::time_point> sent(share.count);
+        share.latency_us.reserve(share.count);
+        int next = 0, received = 0;
+        std::string pending;
+        std::vector<char> buffer(1 << 16);
+        protocol::Message reply;
+        while (received < share.count)
+        {
+            std::string out;
+            auto now = Clock::now();
+            for (; next < share.count && next - received < window; ++next)
+            {
+                sent[next] = now;
+                out += request_line(share.first + next, op, puzzles);
+            }
+            if (!out.empty() && !write_all(fd, out)) break;
+
+            ssize_t got = ::read(fd, buffer.data(), buffer.size());
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) break;
+            pending.append(buffer.data(), (std::size_t)got);
+
+            now = Clock::now();
+            std::size_t start = 0, end;
+            while ((end = pending.find('\n', start)) != std::string::npos)
+            {
+                int index = -1;
+                if (reply.parse(pending.substr(start, end - start)))
+                {
+                    index = (int)reply.number("id", -1) - share.first;
+                }
+                if (index >= 0 && index < next)
+                {
+                    share.latency_us.push_back(std::chrono::duration<double, std::micro>(now - sent[index]).count());
+                }
+                if (index < 0 || index >= next || !reply.flag("ok")) ++share.errors;
+                ++received;
+                start = end + 1;
+            }
+            pending.erase(0, start);
+        }
+        share.failed = received < share.count;
+    }
+
+    int usage()
+    {
+        std::cerr << "usage: sudoku-load [-u socket_path] [-c connections] [-n requests] [-w window] [-o op] [file]\n";
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* socket_path = "sudoku.sock";
+    int connections = 4;
+    int requests = 1000;
+    int window = 16;
+    std::string op = "solve";
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-u") == 0 && i + 1 < argc)
+        {
+            socket_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+        {
+            connections = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            requests = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+        {
+            window = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            op = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
+        {
+            usage();
+            return 0;
+        }
+        else if (argv[i][0] == '-')
+        {
+            return usage();
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+    if (op != "solve" && op != "validate" && op != "rate" && op != "generate") return usage();
+
+    std::vector<std::string> puzzles;
+    if (path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::cerr << "sudoku-load: cannot open " << path << "\n";
+            return 1;
+        }
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#') continue;
+            puzzles.push_back(line);
+        }
+    }
+    else
+    {
+        puzzles.assign(std::begin(bench::hard9), std::end(bench::hard9));
+    }
+    if (puzzles.empty())
+    {
+        std::cerr << "sudoku-load: no puzzles\n";
+        return 1;
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+    connections = std::min(connections, requests);
+    std::vector<Share> shares(connections);
+    std::vector<int> fds(connections);
+    for (int c = 0; c < connections; ++c)
+    {
+        shares[c].first = (int)((long long)requests * c / connections);
+        shares[c].count = (int)((long long)requests * (c + 1) / connections) - shares[c].first;
+        fds[c] = connect_to(socket_path);
+        if (fds[c] < 0)
+        {
+            std::cerr << "sudoku-load: cannot connect to " << socket_path << ": " << std::strerror(errno) << "\n";
+            return 1;
+        }
+    }
+
+    auto start = Clock::now();
+    {
+        std::vector<std::thread> threads;
+        for (int c = 0; c < connections; ++c)
+        {
+            threads.emplace_back([&, c] { run_share(fds[c], shares[c], window, op, puzzles); });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    int errors = 0;
+    bool failed = false;
+    std::vector<double> latency_us; // Unanswered requests of a broken connection have no latency and are left out
+    for (int c = 0; c < connections; ++c)
+    {
+        errors += shares[c].errors;
+        failed = failed || shares[c].failed;
+        latency_us.insert(latency_us.end(), shares[c].latency_us.begin(), shares[c].latency_us.end());
+        close(fds[c]);
+    }
+    std::sort(latency_us.begin(), latency_us.end());
+
+    protocol::Object summary;
+    summary.add("op", op);
+    summary.add("connections", connections);
+    summary.add("window", window);
+    summary.add("requests", requests);
+    summary.add("answered", (int)latency_us.size());
+    summary.add("errors", errors);
+    summary.add("per_sec", seconds > 0 ? latency_us.size() / seconds : 0.0);
+    summary.add("p50_us", timing::percentile(latency_us, 50));
+    summary.add("p99_us", timing::percentile(latency_us, 99));
+    summary.add("max_us", latency_us.empty() ? 0.0 : latency_us.back());
+    std::cout << summary.str() << "\n";
+    if (failed) std::cerr << "sudoku-load: a connection closed before every answer came back\n";
+    return errors || failed ? 2 : 0;
+}
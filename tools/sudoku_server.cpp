@@ -0,0 +1,502 @@
+// Solver daemon: answers line-delimited JSON requests on a Unix domain socket,
+// or on stdin/stdout, from a pool of workers that keep their lookup tables,
+// raters and generators warm between requests.
+//
+//   sudoku-server [-j threads] [-b batch] [-t milliseconds] [-u socket_path]
+//
+// Every request is one JSON object on one line with an "op" and an optional
+// "id", which the response echoes:
+//
+//   {"id": 1, "op": "solve", "puzzle": "...", "stats": true}
+//   {"id": 2, "op": "generate", "size": 9, "level": 3, "seed": 42}
+//   {"id": 3, "op": "validate", "puzzle": "..."}
+//   {"id": 4, "op": "rate", "puzzle": "..."}
+//
+// Each response is one line, {"id": ..., "ok": true, ...} or {"id": ...,
+// "ok": false, "error": "..."}, and they may come back out of order. The lines
+// one read brings in are cut into batches spread over the workers, at most -b
+// requests each (64 by default); a batch is one pool task and one write.
+// Without -u the server answers stdin on stdout and exits at end of input.
+//
+// No request holds a worker for long: solve and generate give up after -t
+// milliseconds (10000 by default, "budget_ms" asks for less), validate and
+// rate after max_request_nodes branches ("max_nodes" asks for fewer), and
+// generate takes sizes up to MAX_GENERATE_SIZE. A request that runs out
+// answers "ok": false with the error "budget exceeded".
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "generator.hpp"
+#include "puzzle_io.hpp"
+#include "rating.hpp"
+#include "server_protocol.hpp"
+#include "solution_counter.hpp"
+#include "solve.hpp"
+#include "thread_pool.hpp"
+
+namespace
+{
+    constexpr std::size_t max_line = 1 << 20; // Longest request accepted, a 100x100 puzzle is about 30 KB
+    constexpr long long max_request_nodes = 1 << 18; // Branches validate and rate may take, seconds on 25x25
+    const std::string budget_exceeded = "budget exceeded";
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Lut
+    {
+        solver::SubgridLut table;
+    };
+
+    std::vector<std::unique_ptr<Lut>> luts(MAX_BOARD_SIZE + 1); // Every supported size, built at startup and shared read-only
+
+    // What a worker keeps between requests, built on its first request of each size
+    struct Workspace
+    {
+        std::vector<std::unique_ptr<generator::SudokuGenerator>> generators = std::vector<std::unique_ptr<generator::SudokuGenerator>>(MAX_BOARD_SIZE + 1);
+        std::vector<std::unique_ptr<solver::SolutionCounter>> counters = std::vector<std::unique_ptr<solver::SolutionCounter>>(MAX_BOARD_SIZE + 1);
+        std::vector<std::unique_ptr<solver::Rater>> raters = std::vector<std::unique_ptr<solver::Rater>>(MAX_BOARD_SIZE + 1);
+    };
+
+    thread_local Workspace workspace; // Pool threads live as long as the server
+
+    const char* socket_path = nullptr;
+    double max_request_ms = 10000; // -t
+
+    // Cancels the requests that run past their deadline: every request
+    // registers its Progress, one thread looks them over every few milliseconds
+    class Watchdog
+    {
+    public:
+        Watchdog() : thread([this] { loop(); }) {}
+
+        ~Watchdog()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            thread.join();
+        }
+
+        void watch(parallel::Progress* progress, Clock::time_point deadline)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.push_back({progress, deadline});
+        }
+
+        void unwatch(parallel::Progress* progress)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.progress == progress; }),
+                          entries.end());
+        }
+
+    private:
+        struct Entry
+        {
+            parallel::Progress* progress;
+            Clock::time_point deadline;
+        };
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<Entry> entries;
+        bool stopping = false;
+        std::thread thread; // Last, so it starts once the rest is built
+
+        void loop()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!stopping)
+            {
+                wake.wait_for(lock, std::chrono::milliseconds(5));
+                auto now = Clock::now();
+                for (const Entry& entry : entries)
+                {
+                    if (entry.deadline <= now) entry.progress->cancel.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    Watchdog* watchdog = nullptr; // Built by main
+
+    // Limits of one request, watched from construction to destruction
+    struct Budget
+    {
+        parallel::Progress progress; // Cancelled by the watchdog at the deadline
+        long long max_nodes; // For the counting ops
+
+        explicit Budget(const protocol::Message& request)
+        {
+            long long ms = request.number("budget_ms", 0);
+            long long nodes = request.number("max_nodes", 0);
+            max_nodes = nodes > 0 ? std::min(nodes, max_request_nodes) : max_request_nodes;
+            double limit = ms > 0 ? std::min((double)ms, max_request_ms) : max_request_ms;
+            watchdog->watch(&progress, Clock::now() + std::chrono::microseconds((long long)(limit * 1000)));
+        }
+        ~Budget() { watchdog->unwatch(&progress); }
+
+        Budget(const Budget&) = delete;
+        Budget& operator=(const Budget&) = delete;
+    };
+
+    // The puzzle field of request parsed into board, else the error
+    std::string read_puzzle(const protocol::Message& request, solver::Board& board)
+    {
+        const protocol::Field* puzzle = request.find("puzzle");
+        if (!puzzle || !puzzle->quoted) return "missing puzzle";
+        if (!solver::parse_puzzle(puzzle->value, board)) return "malformed puzzle";
+        return "";
+    }
+
+    // Easiest level (1-5) whose technique limit covers hardest, see generator::technique_for_level
+    int level_of(solver::Technique hardest)
+    {
+        int level = 1;
+        while (level < 5 && hardest > generator::technique_for_level(level)) ++level;
+        return level;
+    }
+
+    std::string solve(const protocol::Message& request, Budget& budget, protocol::Object& body)
+    {
+        solver::Board board;
+        std::string error = read_puzzle(request, board);
+        if (!error.empty()) return error;
+
+        int n = (int)board.size();
+        bool with_stats = request.flag("stats");
+        solver::SearchStats stats;
+        solver::Result result = solver::solve(board, solver::subgrid_size_of(n), luts[n]->table, nullptr, &budget.progress,
+                                              with_stats ? &stats : nullptr);
+        if (result == solver::Result::Invalid) return "givens conflict";
+        if (result == solver::Result::Cancelled) return budget_exceeded;
+        if (result != solver::Result::Solved) return "unsolvable";
+
+        body.add("solution", solver::format_puzzle(board));
+        body.add("nodes", (long long)budget.progress.nodes.load(std::memory_order_relaxed));
+        if (with_stats) body.raw("stats", stats.to_json());
+        return "";
+    }
+
+    std::string generate(const protocol::Message& request, Budget& budget, protocol::Object& body)
+    {
+        long long size = request.number("size", 9);
+        long long level = request.number("level", 3);
+        if (size < 1 || size > MAX_BOARD_SIZE || !solver::subgrid_size_of((int)size)) return "invalid size";
+        if (size > MAX_GENERATE_SIZE) return "too large to generate";
+        if (level < 1 || level > 5) return "invalid level";
+
+        auto& generator = workspace.generators[size];
+        if (!generator)
+        {
+            generator = std::make_unique<generator::SudokuGenerator>((int)size, generator::default_fill_mode((int)size));
+        }
+        if (request.find("seed"))
+        {
+            generator->seed((std::uint64_t)request.number("seed")); // The same seed gives the same puzzle on any worker
+        }
+
+        solver::Board puzzle, solution;
+        solver::Rating rating;
+        generator->set_progress(&budget.progress); // Stops early at the deadline, with a puzzle easier than asked
+        if (size <= MAX_RATING_SIZE)
+        {
+            generator->generate_rated((int)level, puzzle, solution, &rating);
+        }
+        else
+        {
+            generator->generate_puzzle(generator::clues_for_level((int)level, (int)size), puzzle, solution);
+        }
+        generator->set_progress(nullptr);
+        if (budget.progress.cancelled()) return budget_exceeded;
+
+        if (size <= MAX_RATING_SIZE) body.add("technique", solver::technique_name(rating.hardest));
+        body.add("puzzle", solver::format_puzzle(puzzle));
+        body.add("solution", solver::format_puzzle(solution));
+        return "";
+    }
+
+    std::string validate(const protocol::Message& request, Budget& budget, protocol::Object& body)
+    {
+        solver::Board board;
+        std::string error = read_puzzle(request, board);
+        if (!error.empty()) return error;
+
+        int n = (int)board.size();
+        auto& counter = workspace.counters[n];
+        if (!counter) counter = solver::make_solution_counter(n);
+        bool consistent = counter->load(board);
+        int solutions = consistent ? counter->count(2, budget.max_nodes) : 0;
+        if (solutions < 0) return budget_exceeded;
+        body.add("conflicts", !consistent);
+        body.add("solutions", solutions); // 2 stands for two or more
+        body.add("unique", solutions == 1);
+        return "";
+    }
+
+    std::string rate(const protocol::Message& request, Budget& budget, protocol::Object& body)
+    {
+        solver::Board board;
+        std::string error = read_puzzle(request, board);
+        if (!error.empty()) return error;
+
+        int n = (int)board.size();
+        if (n > MAX_RATING_SIZE) return "too large to rate";
+        auto& rater = workspace.raters[n];
+        if (!rater) rater = std::make_unique<solver::Rater>(n);
+        solver::Rating rating = rater->rate(board, solver::Technique::Search, budget.max_nodes);
+        if (rating.solutions < 0) return budget_exceeded;
+        body.add("technique", solver::technique_name(rating.hardest));
+        body.add("level", level_of(rating.hardest));
+        body.add("steps", rating.steps);
+        body.add("nodes", rating.nodes);
+        body.add("solutions", rating.solutions);
+        return "";
+    }
+
+    // The response line to one request line, without its newline
+    std::string handle(const std::string& line)
+    {
+        auto begin = Clock::now();
+        protocol::Message request;
+        protocol::Object reply;
+        protocol::Object body;
+        std::string error;
+        const protocol::Field* id = nullptr;
+        if (!request.parse(line))
+        {
+            error = "malformed request";
+        }
+        else if ((id = request.find("id")) && !id->quoted && !id->is_number())
+        {
+            id = nullptr;
+            error = "id must be a string or a number";
+        }
+        else
+        {
+            std::string op = request.text_of("op");
+            try
+            {
+                Budget budget(request);
+                if (op == "solve") error = solve(request, budget, body);
+                else if (op == "generate") error = generate(request, budget, body);
+                else if (op == "validate") error = validate(request, budget, body);
+                else if (op == "rate") error = rate(request, budget, body);
+                else error = "unknown op";
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+        }
+
+        reply.raw("id", id ? id->raw : "null");
+
+        reply.add("ok", error.empty());
+        if (error.empty()) reply.append(body);
+        else reply.add("error", error);
+        reply.add("us", std::chrono::duration<double, std::micro>(Clock::now() - begin).count());
+        return reply.str();
+    }
+
+    // Writes all of text, false when the peer is gone
+    bool write_all(int fd, const std::string& text)
+    {
+        std::size_t done = 0;
+        while (done < text.size())
+        {
+            ssize_t written = ::write(fd, text.data() + done, text.size() - done);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            done += (std::size_t)written;
+        }
+        return true;
+    }
+
+    // Answers the requests read from in on out until end of input, returns
+    // once every answer is written
+    void serve(int in, int out, parallel::WorkStealingPool& pool, int max_batch)
+    {
+        std::mutex write_mutex; // One batch's answers go out in one piece
+        parallel::TaskGroup group(pool);
+        std::vector<std::string> lines;
+
+        // Splits lines evenly over the workers, at most max_batch per task
+        auto submit = [&]
+        {
+            int count = (int)lines.size();
+            int batch = std::max(1, std::min(max_batch, (count + pool.size() - 1) / pool.size()));
+            for (int first = 0; first < count; first += batch)
+            {
+                std::vector<std::string> requests(std::make_move_iterator(lines.begin() + first),
+                                                  std::make_move_iterator(lines.begin() + std::min(count, first + batch)));
+                group.run([requests = std::move(requests), out, &write_mutex]
+                {
+                    std::string replies;
+                    for (const std::string& request : requests)
+                    {
+                        replies += handle(request);
+                        replies += '\n';
+                    }
+                    std::lock_guard<std::mutex> lock(write_mutex);
+                    write_all(out, replies);
+                });
+            }
+            lines.clear();
+        };
+
+        std::string pending; // Bytes after the last complete line
+        std::vector<char> buffer(1 << 16);
+        while (true)
+        {
+            ssize_t got = ::read(in, buffer.data(), buffer.size());
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) break;
+            pending.append(buffer.data(), (std::size_t)got);
+
+            std::size_t start = 0, end;
+            while ((end = pending.find('\n', start)) != std::string::npos)
+            {
+                if (pending.find_first_not_of(" \t\r", start) < end) lines.push_back(pending.substr(start, end - start));
+                start = end + 1;
+            }
+            pending.erase(0, start);
+            submit();
+
+            if (pending.size() > max_line)
+            {
+                std::lock_guard<std::mutex> lock(write_mutex);
+                write_all(out, "{\"id\": null, \"ok\": false, \"error\": \"request too long\"}\n");
+                pending.clear();
+                break;
+            }
+        }
+        if (pending.find_first_not_of(" \t\r") != std::string::npos)
+        {
+            lines.push_back(pending); // The last line may lack its newline
+            submit();
+        }
+        group.wait();
+    }
+
+    // Removes the socket file on the way out, unlink is async-signal-safe
+    void stop(int)
+    {
+        if (socket_path) unlink(socket_path);
+        _exit(0);
+    }
+
+    int usage()
+    {
+        std::cerr << "usage: sudoku-server [-j threads] [-b batch] [-t milliseconds] [-u socket_path]\n";
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int threads = 0;
+    int max_batch = 64;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+        {
+            max_batch = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            max_request_ms = std::max(1.0, std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "-u") == 0 && i + 1 < argc)
+        {
+            socket_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
+        {
+            usage();
+            return 0;
+        }
+        else
+        {
+            return usage();
+        }
+    }
+
+    for (int n = 1; n <= MAX_BOARD_SIZE; ++n)
+    {
+        int subgrid_size = solver::subgrid_size_of(n);
+        if (!subgrid_size) continue;
+        luts[n] = std::make_unique<Lut>();
+        solver::fill_subgrid_lut(luts[n]->table, n, subgrid_size);
+    }
+
+    std::signal(SIGPIPE, SIG_IGN); // A client that hangs up fails its write instead of killing the server
+    Watchdog deadlines;
+    watchdog = &deadlines;
+    parallel::WorkStealingPool pool(threads); // Joined before the watchdog goes
+
+    if (!socket_path)
+    {
+        serve(STDIN_FILENO, STDOUT_FILENO, pool, max_batch);
+        return 0;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(socket_path) >= sizeof(address.sun_path))
+    {
+        std::cerr << "sudoku-server: socket path too long\n";
+        return 1;
+    }
+    std::strcpy(address.sun_path, socket_path);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socket_path); // Left over from a server that was killed
+    if (listener < 0 || bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 64) < 0)
+    {
+        std::cerr << "sudoku-server: cannot listen on " << socket_path << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+    std::fprintf(stderr, "sudoku-server: listening on %s with %d workers\n", socket_path, pool.size());
+
+    // One reader thread per connection, the work itself goes to the shared pool
+    while (true)
+    {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            std::cerr << "sudoku-server: accept failed: " << std::strerror(errno) << "\n";
+            stop(0);
+        }
+        std::thread([client, &pool, max_batch]
+        {
+            serve(client, client, pool, max_batch);
+            close(client);
+        }).detach();
+    }
+}
@@ -0,0 +1,219 @@
+// Headless batch solver: reads one puzzle per line from a file or stdin,
+// solves them on all cores and writes the solutions in input order.
+//
+//   sudoku-solve [-j threads] [-s stats_file] [file]
+//
+// Lines that are empty or start with '#' are skipped. Unsolvable or malformed
+// puzzles produce the line "unsolvable" or "invalid". Throughput and latency
+// percentiles go to stderr. -s writes the search statistics of every puzzle
+// to stats_file, one JSON object per line in input order ("null" for
+// malformed lines); they are empty in a RELEASE=1 build.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bitplane9.hpp"
+#include "board.hpp"
+#include "puzzle_io.hpp"
+#include "solve.hpp"
+#include "thread_pool.hpp"
+#include "timing.hpp"
+
+namespace
+{
+    constexpr int max_chunk_size = 256; // Puzzles per pool task, fewer when that would leave cores idle
+
+    struct Lut
+    {
+        solver::SubgridLut table;
+    };
+
+    struct Totals
+    {
+        int solved = 0;
+        int unsolvable = 0;
+        int invalid = 0;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    int threads = 0;
+    const char* path = nullptr;
+    const char* stats_path = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            threads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            stats_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0)
+        {
+            std::cerr << "usage: sudoku-solve [-j threads] [-s stats_file] [file]\n";
+            return 0;
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    std::ifstream file;
+    if (path)
+    {
+        file.open(path);
+        if (!file)
+        {
+            std::cerr << "sudoku-solve: cannot open " << path << "\n";
+            return 1;
+        }
+    }
+    std::istream& in = path ? file : std::cin;
+
+    std::ofstream stats_file;
+    if (stats_path)
+    {
+        stats_file.open(stats_path);
+        if (!stats_file)
+        {
+            std::cerr << "sudoku-solve: cannot write " << stats_path << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        lines.push_back(std::move(line));
+    }
+
+    // Lookup tables for every supported size, shared read-only by the workers
+    std::vector<std::unique_ptr<Lut>> luts(MAX_BOARD_SIZE + 1);
+    for (int n = 1; n <= MAX_BOARD_SIZE; ++n)
+    {
+        int subgrid_size = solver::subgrid_size_of(n);
+        if (!subgrid_size) continue;
+        luts[n] = std::make_unique<Lut>();
+        solver::fill_subgrid_lut(luts[n]->table, n, subgrid_size);
+    }
+
+    int count = (int)lines.size();
+    std::vector<std::string> results(count);
+    std::vector<double> latency_us(count);
+    std::vector<std::string> stats_lines(stats_path ? count : 0, "null");
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Totals> chunk_totals;
+    {
+        parallel::WorkStealingPool pool(threads);
+        // About four chunks per thread, so the last ones to finish are short
+        int chunk_size = std::max(1, std::min(max_chunk_size, count / (pool.size() * 4)));
+        chunk_totals.resize((count + chunk_size - 1) / chunk_size);
+
+        // Solves puzzles first .. first + chunk_size - 1, with the parallel
+        // search on search_pool when it is given
+        auto solve_chunk = [&](int first, parallel::WorkStealingPool* search_pool)
+        {
+            Totals& totals = chunk_totals[first / chunk_size];
+            solver::Board board;
+            int last = std::min(count, first + chunk_size);
+            for (int i = first; i < last; ++i)
+            {
+                auto begin = std::chrono::steady_clock::now();
+                if (!solver::parse_puzzle(lines[i], board))
+                {
+                    latency_us[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+                    results[i] = "invalid";
+                    ++totals.invalid;
+                    continue;
+                }
+
+                int n = (int)board.size();
+                solver::SearchStats stats;
+                solver::Result result = solver::solve(board, solver::subgrid_size_of(n), luts[n]->table, search_pool, nullptr,
+                                                      stats_path ? &stats : nullptr);
+                latency_us[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+                if (stats_path) stats_lines[i] = stats.to_json();
+
+                if (result == solver::Result::Solved)
+                {
+                    results[i] = solver::format_puzzle(board);
+                    ++totals.solved;
+                }
+                else if (result == solver::Result::Invalid)
+                {
+                    results[i] = "invalid";
+                    ++totals.invalid;
+                }
+                else
+                {
+                    results[i] = "unsolvable";
+                    ++totals.unsolvable;
+                }
+            }
+        };
+
+        if (count < pool.size())
+        {
+            // Too few puzzles to keep every core busy: one at a time from
+            // here, each searched on the whole pool (16x16 and up)
+            for (int first = 0; first < count; first += chunk_size)
+            {
+                solve_chunk(first, &pool);
+            }
+        }
+        else
+        {
+            parallel::TaskGroup group(pool);
+            for (int first = 0; first < count; first += chunk_size)
+            {
+                group.run([&, first] { solve_chunk(first, nullptr); });
+            }
+            group.wait();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::string out;
+    for (const auto& result : results)
+    {
+        out += result;
+        out.push_back('\n');
+    }
+    std::fwrite(out.data(), 1, out.size(), stdout);
+
+    for (const auto& stats_line : stats_lines)
+    {
+        stats_file << stats_line << '\n';
+    }
+
+    Totals totals;
+    for (const auto& chunk : chunk_totals)
+    {
+        totals.solved += chunk.solved;
+        totals.unsolvable += chunk.unsolvable;
+        totals.invalid += chunk.invalid;
+    }
+    std::sort(latency_us.begin(), latency_us.end());
+
+    std::fprintf(stderr, "puzzles: %d  solved: %d  unsolvable: %d  invalid: %d\n",
+                 count, totals.solved, totals.unsolvable, totals.invalid);
+    std::fprintf(stderr, "wall: %.3f s  throughput: %.0f puzzles/s  9x9 kernel: %s\n",
+                 seconds, seconds > 0 ? count / seconds : 0.0, solver::bitplane9_isa());
+    std::fprintf(stderr, "latency us: p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+                 timing::percentile(latency_us, 50), timing::percentile(latency_us, 90), timing::percentile(latency_us, 99),
+                 latency_us.empty() ? 0.0 : latency_us.back());
+    return totals.invalid || totals.unsolvable ? 2 : 0;
+}